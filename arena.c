@@ -0,0 +1,129 @@
+/*
+ * arena.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Bump-pointer arena allocator used for bulk loading of Person names.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "arena.h"
+
+// every allocation is aligned to this many bytes
+#define ARENA_ALIGNMENT 8
+
+/*
+ * arena_init - prepare an empty arena, no memory is allocated yet
+ * @arena: arena to initialize
+ * @chunk_size: size of the chunks, 0 means ARENA_DEFAULT_CHUNK
+ */
+void arena_init(Arena *arena, size_t chunk_size)
+{
+    arena->head = NULL;
+    arena->chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK;
+    arena->chunk_count = 0;
+}
+
+/*
+ * new_chunk - allocate a chunk with at least size bytes
+ * Returns: the new chunk or NULL when malloc fails
+ * A normal chunk becomes the head. An oversized one (bigger than chunk_size)
+ * is linked behind the head instead, so the space left in the head is still
+ * used by the following small allocations.
+ */
+static ArenaChunk *new_chunk(Arena *arena, size_t size)
+{
+    int oversized = size > arena->chunk_size;
+    if (!oversized) size = arena->chunk_size;
+
+    ArenaChunk *chunk = malloc(sizeof(ArenaChunk) + size);
+    if (!chunk) return NULL;
+
+    chunk->size = size;
+    chunk->used = 0;
+    if (oversized && arena->head) {
+        chunk->next = arena->head->next;
+        arena->head->next = chunk;
+    } else {
+        chunk->next = arena->head;
+        arena->head = chunk;
+    }
+    arena->chunk_count++;
+    return chunk;
+}
+
+/*
+ * arena_alloc - take size bytes from the current chunk
+ * @arena: arena
+ * @size: number of bytes
+ *
+ * Returns: pointer to the memory or NULL when malloc fails
+ * The memory must NOT be passed to free(), it lives until arena_reset/arena_free
+ */
+void *arena_alloc(Arena *arena, size_t size)
+{
+    if (!arena) return NULL;
+
+    // round up so that the next allocation stays aligned
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    ArenaChunk *chunk = arena->head;
+    if (!chunk || chunk->size - chunk->used < size) {
+        chunk = new_chunk(arena, size);
+        if (!chunk) return NULL;
+    }
+
+    void *p = chunk->data + chunk->used;
+    chunk->used += size;
+    return p;
+}
+
+/*
+ * arena_reset - release everything allocated from the arena
+ * The head chunk is kept, so that the next load can reuse it
+ */
+void arena_reset(Arena *arena)
+{
+    if (!arena || !arena->head) return;
+
+    ArenaChunk *chunk = arena->head->next;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    arena->head->next = NULL;
+    arena->head->used = 0;
+    arena->chunk_count = 1;
+}
+
+// Release all the memory of the arena, including the last chunk
+void arena_free(Arena *arena)
+{
+    if (!arena) return;
+
+    arena_reset(arena);
+    free(arena->head);
+    arena->head = NULL;
+    arena->chunk_count = 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * arena.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Bump-pointer arena allocator.
+ * All allocations are taken from large chunks and released together with one
+ * arena_reset() (or arena_free()), instead of one free() per allocation.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// default size of one arena chunk (1 MB)
+#define ARENA_DEFAULT_CHUNK (1024 * 1024)
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;    // filled (or oversized) chunks behind the head
+    size_t             size;    // bytes available in data
+    size_t             used;    // bytes already handed out
+    unsigned char      data[];  // the memory itself
+} ArenaChunk;
+
+typedef struct {
+    ArenaChunk *head;           // chunk we are allocating from
+    size_t      chunk_size;     // size of new chunks
+    size_t      chunk_count;    // number of chunks currently allocated
+} Arena;
+
+void arena_init(Arena *arena, size_t chunk_size);
+void *arena_alloc(Arena *arena, size_t size);
+void arena_reset(Arena *arena);
+void arena_free(Arena *arena);
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * bench.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Common helpers for the benchmarks (make bench).
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "person.h"
+#include "transition_table.h"
+
+// number of records used by the file benchmarks
+#define BENCH_RECORDS 1000000
+
+// monotonic time in seconds
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// helpers from bench_main.c
+Person *bench_make_persons(size_t count);
+void bench_free_persons(Person *persons, size_t count);
+int bench_write_people_file(const char *filename, size_t count);
+bool bench_guard_rare(void);
+void bench_guard_rare_batch(const uint32_t *instances, size_t count, bool *results, void *context);
+Transition *bench_make_transitions(size_t state_count, size_t per_state, size_t *count);
+
+// one function per benchmark
+void bench_person_writer(void);
+void bench_person_mmap(void);
+void bench_person_arena(void);
+void bench_person_table(void);
+void bench_person_parallel(void);
+void bench_person_stream(void);
+void bench_person_block(void);
+void bench_person_varint(void);
+void bench_fixed_record(void);
+void bench_transition_index(void);
+void bench_state_engine(void);
+void bench_shard_runtime(void);
+void bench_event_queue(void);
+void bench_state_dispatch(void);
+void bench_state_timers(void);
+void bench_state_trace(void);
+void bench_state_suite(void);
+void bench_state_snapshot(void);
+void bench_weekday_set(void);
+void bench_weekday_convert(void);
+void bench_weekday_tz(void);
+void bench_variant(void);
+void bench_variant_column(void);
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * bench_event_queue.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: event-driven state machine - throughput of the MPSC queue with
+ * several producers, and event-to-transition latency when the machine is asleep.
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "bench.h"
+#include "states_events.h"
+
+#define BENCH_PRODUCERS      4
+#define BENCH_EVENTS         250000     // per producer
+#define BENCH_LATENCY_EVENTS 1000
+
+static const Transition bench_table[] = {
+    { STATE_INIT,   NULL,              STATE_STILL },
+    { STATE_STILL,  event_is_start,    STATE_MOVING },
+    { STATE_STILL,  event_is_shutdown, STATE_STOP },
+    { STATE_MOVING, event_is_shutdown, STATE_STOP },
+    { STATE_MOVING, event_is_stop,     STATE_STILL },
+};
+
+#define BENCH_TABLE_COUNT (sizeof(bench_table) / sizeof(bench_table[0]))
+
+typedef struct {
+    EventQueue *q;
+    size_t      events;
+    int         pause_us;       // sleep between events (0 = as fast as possible)
+    int         shutdown;       // push EVENT_SHUTDOWN after the events
+} Producer;
+
+// push start/stop pairs, retrying when the queue is full
+static void *producer_thread(void *arg)
+{
+    Producer *p = arg;
+
+    for (size_t i = 0; i < p->events; i++) {
+        EventType type = (i & 1) ? EVENT_STOP : EVENT_START;
+        while (!event_queue_push(p->q, type, 0))
+            sched_yield();
+        if (p->pause_us) usleep(p->pause_us);
+    }
+
+    if (p->shutdown) {
+        while (!event_queue_push(p->q, EVENT_SHUTDOWN, 0))
+            sched_yield();
+    }
+    return NULL;
+}
+
+void bench_event_queue(void)
+{
+    EventQueue q;
+    EventStats stats = {0};
+    pthread_t threads[BENCH_PRODUCERS];
+    Producer producers[BENCH_PRODUCERS];
+
+    // 1) throughput: several producers as fast as possible
+    if (!event_queue_init(&q, 4096)) return;
+
+    double start = bench_now();
+    for (int i = 0; i < BENCH_PRODUCERS; i++) {
+        producers[i] = (Producer){ &q, BENCH_EVENTS, 0, 0 };
+        pthread_create(&threads[i], NULL, producer_thread, &producers[i]);
+    }
+
+    // the machine consumes all the events
+    Event event;
+    size_t consumed = 0;
+    State state = event_machine_step(bench_table, BENCH_TABLE_COUNT, STATE_INIT, EVENT_NONE);
+    while (consumed < (size_t)BENCH_PRODUCERS * BENCH_EVENTS) {
+        if (event_queue_wait(&q, &event, -1)) {
+            state = event_machine_step(bench_table, BENCH_TABLE_COUNT, state, event.type);
+            consumed++;
+        }
+    }
+    double elapsed = bench_now() - start;
+    for (int i = 0; i < BENCH_PRODUCERS; i++)
+        pthread_join(threads[i], NULL);
+
+    printf("%d producers:   %12.0f events/s\n", BENCH_PRODUCERS, consumed / elapsed);
+    event_queue_free(&q);
+
+    // 2) latency: one slow producer, the machine sleeps between events
+    if (!event_queue_init(&q, 64)) return;
+
+    producers[0] = (Producer){ &q, BENCH_LATENCY_EVENTS, 100, 1 };
+    pthread_create(&threads[0], NULL, producer_thread, &producers[0]);
+    event_machine_run(bench_table, BENCH_TABLE_COUNT, &q, &stats);
+    pthread_join(threads[0], NULL);
+
+    printf("wake-up latency: avg %.1f us, max %.1f us (%llu transitions)\n",
+           stats.transitions ? stats.total_latency_ns / 1000.0 / stats.transitions : 0.0,
+           stats.max_latency_ns / 1000.0, (unsigned long long)stats.transitions);
+    event_queue_free(&q);
+}
@@ -0,0 +1,96 @@
+/*
+ * bench_fixed_record.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: reading struct_person records one fread at a time against one
+ * bulk fread and against mapping the file as an array.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "fixed_record.h"
+#include "structure_definition.h"
+
+#define BENCH_FILE "bench_people.frec"
+
+void bench_fixed_record(void)
+{
+    struct_person *persons = calloc(BENCH_RECORDS, sizeof(struct_person));
+    if (!persons) return;
+
+    for (size_t i = 0; i < BENCH_RECORDS; i++) {
+        persons[i].iAge = (int)(i % 100);
+        snprintf(persons[i].name, sizeof(persons[i].name), "Person_%zu", i);
+        strcpy(persons[i].address, "Gothenburg");
+    }
+    if (!fixed_record_save(BENCH_FILE, &fixed_layout_person, persons, BENCH_RECORDS)) {
+        printf("could not write %s\n", BENCH_FILE);
+        free(persons);
+        return;
+    }
+
+    // 1) one fread per record, as in demo_write_binary
+    long long age_sum = 0;
+    size_t count = 0;
+    double start = bench_now();
+    FILE *f = fopen(BENCH_FILE, "rb");
+    uint64_t announced;
+    if (f && fixed_record_read_header(f, &fixed_layout_person, &announced)) {
+        while (count < BENCH_RECORDS && fread(&persons[count], sizeof(struct_person), 1, f) == 1)
+            age_sum += persons[count++].iAge;
+    }
+    if (f) fclose(f);
+    double single_time = bench_now() - start;
+    printf("fread per record:  %12.0f records/s (%zu records, ages=%lld)\n",
+           count / single_time, count, age_sum);
+
+    // 2) one fread for all the records into the preallocated array
+    age_sum = 0;
+    start = bench_now();
+    count = fixed_record_load(BENCH_FILE, &fixed_layout_person, persons, BENCH_RECORDS);
+    for (size_t i = 0; i < count; i++)
+        age_sum += persons[i].iAge;
+    double bulk_time = bench_now() - start;
+    printf("bulk fread:        %12.0f records/s (%zu records, ages=%lld)\n",
+           count / bulk_time, count, age_sum);
+
+    // 3) mmap - the file is the array
+    age_sum = 0;
+    count = 0;
+    start = bench_now();
+    FixedRecordMap map;
+    if (fixed_record_map_open(&map, BENCH_FILE, &fixed_layout_person)) {
+        const struct_person *mapped = map.records;
+        for (size_t i = 0; i < map.count; i++)
+            age_sum += mapped[i].iAge;
+        count = map.count;
+        fixed_record_map_close(&map);
+    }
+    double map_time = bench_now() - start;
+    printf("mmap array:        %12.0f records/s (%zu records, ages=%lld)\n",
+           count / map_time, count, age_sum);
+
+    free(persons);
+    remove(BENCH_FILE);
+}
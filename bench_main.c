@@ -0,0 +1,186 @@
+/*
+ * bench_main.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark driver. Runs all benchmarks or only the ones given on the
+ * command line, e.g. ./lecture3_bench writer
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "person_writer.h"
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} Benchmark;
+
+static const Benchmark benchmarks[] = {
+    { "writer", bench_person_writer },
+    { "mmap",   bench_person_mmap },
+    { "arena",  bench_person_arena },
+    { "table",  bench_person_table },
+    { "parallel", bench_person_parallel },
+    { "stream", bench_person_stream },
+    { "block",  bench_person_block },
+    { "varint", bench_person_varint },
+    { "fixed",  bench_fixed_record },
+    { "index",  bench_transition_index },
+    { "engine", bench_state_engine },
+    { "shards", bench_shard_runtime },
+    { "events", bench_event_queue },
+    { "dispatch", bench_state_dispatch },
+    { "timers", bench_state_timers },
+    { "trace",  bench_state_trace },
+    { "states", bench_state_suite },
+    { "snapshot", bench_state_snapshot },
+    { "weekdays", bench_weekday_set },
+    { "weekday-convert", bench_weekday_convert },
+    { "weekday-tz", bench_weekday_tz },
+    { "variant", bench_variant },
+    { "variant-columns", bench_variant_column },
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/*
+ * bench_make_persons - create count persons with names "Person_<i>"
+ * and ages between 0 and 99
+ */
+Person *bench_make_persons(size_t count)
+{
+    Person *persons = malloc(count * sizeof(Person));
+    if (!persons) return NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        char name[32];
+        int len = snprintf(name, sizeof(name), "Person_%zu", i);
+
+        persons[i].name_len = (uint32_t)len;
+        persons[i].age = (int32_t)(i % 100);
+        persons[i].name = malloc(len + 1);
+        if (!persons[i].name) {
+            bench_free_persons(persons, i);
+            return NULL;
+        }
+        memcpy(persons[i].name, name, len + 1);
+    }
+    return persons;
+}
+
+void bench_free_persons(Person *persons, size_t count)
+{
+    if (!persons) return;
+    for (size_t i = 0; i < count; i++)
+        free(persons[i].name);
+    free(persons);
+}
+
+/*
+ * bench_write_people_file - write count synthetic persons to filename
+ * Returns: 1 on success, 0 on failure
+ */
+int bench_write_people_file(const char *filename, size_t count)
+{
+    Person *persons = bench_make_persons(count);
+    if (!persons) return 0;
+
+    PersonWriter *w = person_writer_open(filename, 0);
+    int ok = w && person_writer_append(w, persons, count);
+    if (w && !person_writer_close(w)) ok = 0;
+
+    bench_free_persons(persons, count);
+    return ok;
+}
+
+/*
+ * bench_guard_rare - synthetic guard, true on every 8th call
+ */
+static unsigned rare_calls = 0;
+
+bool bench_guard_rare(void)
+{
+    return (++rare_calls & 7) == 0;
+}
+
+// batch version of bench_guard_rare, same results as calling it count times
+void bench_guard_rare_batch(const uint32_t *instances, size_t count, bool *results, void *context)
+{
+    (void)instances;
+    (void)context;
+
+    unsigned calls = rare_calls;
+    for (size_t i = 0; i < count; i++)
+        results[i] = ((calls + 1 + (unsigned)i) & 7) == 0;
+    rare_calls = calls + (unsigned)count;
+}
+
+/*
+ * bench_make_transitions - synthetic transition table
+ * @state_count: number of states
+ * @per_state: transitions leaving every state; all but the last use
+ *             bench_guard_rare, the last one is unconditional
+ * @count: number of transitions (output)
+ *
+ * The transitions of a state are spread over the whole table (row k of
+ * every state, then row k+1 ...), like in our generated tables.
+ * Returns: the table (release with free()) or NULL
+ */
+Transition *bench_make_transitions(size_t state_count, size_t per_state, size_t *count)
+{
+    Transition *table = malloc(state_count * per_state * sizeof(Transition));
+    if (!table) return NULL;
+
+    unsigned seed = 12345;
+    size_t n = 0;
+    for (size_t k = 0; k < per_state; k++) {
+        for (size_t s = 0; s < state_count; s++) {
+            seed = seed * 1103515245u + 12345u;
+            table[n].from = (State)s;
+            table[n].guard = (k + 1 < per_state) ? bench_guard_rare : NULL;
+            table[n].to = (State)((k + 1 < per_state) ? (seed >> 8) % state_count
+                                                      : (s + 1) % state_count);
+            n++;
+        }
+    }
+
+    *count = n;
+    return table;
+}
+
+int main(int argc, char *argv[])
+{
+    for (size_t i = 0; i < BENCHMARK_COUNT; i++) {
+        // no arguments - run everything
+        int selected = (argc < 2);
+        for (int a = 1; a < argc; a++) {
+            if (strcmp(argv[a], benchmarks[i].name) == 0) selected = 1;
+        }
+        if (!selected) continue;
+
+        printf("== %s\n", benchmarks[i].name);
+        benchmarks[i].run();
+    }
+    return 0;
+}
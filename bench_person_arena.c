@@ -0,0 +1,73 @@
+/*
+ * bench_person_arena.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: bulk load with one malloc per name (read_person) against the
+ * arena-backed load_persons_arena.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "arena.h"
+
+#define BENCH_FILE "bench_people.bin"
+
+void bench_person_arena(void)
+{
+    if (!bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write %s\n", BENCH_FILE);
+        return;
+    }
+
+    // 1) read_person: one malloc per name, one free per name
+    size_t count = 0;
+    double start = bench_now();
+    FILE *f = fopen(BENCH_FILE, "rb");
+    Person *persons = malloc(BENCH_RECORDS * sizeof(Person));
+    if (f && persons) {
+        while (count < BENCH_RECORDS && read_person(f, &persons[count]))
+            count++;
+        for (size_t i = 0; i < count; i++)
+            free_person(&persons[i]);
+    }
+    if (f) fclose(f);
+    free(persons);
+    double malloc_time = bench_now() - start;
+    printf("read_person (malloc/free):  %12.0f records/s (%zu records)\n",
+           count / malloc_time, count);
+
+    // 2) arena: O(chunks) allocations, one reset
+    Arena arena;
+    arena_init(&arena, 0);
+    start = bench_now();
+    persons = load_persons_arena(BENCH_FILE, &arena, &count);
+    size_t chunks = arena.chunk_count;
+    free(persons);
+    arena_reset(&arena);
+    double arena_time = bench_now() - start;
+    printf("load_persons_arena:         %12.0f records/s (%zu records, %zu chunks)\n",
+           count / arena_time, count, chunks);
+
+    arena_free(&arena);
+    remove(BENCH_FILE);
+}
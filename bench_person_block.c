@@ -0,0 +1,94 @@
+/*
+ * bench_person_block.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: file size and read speed of the compressed block format
+ * against the raw read_person() format.
+ */
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include "bench.h"
+#include "person_block.h"
+
+#define BENCH_FILE       "bench_people.bin"
+#define BENCH_BLOCK_FILE "bench_people.pblk"
+
+static long file_size(const char *filename)
+{
+    struct stat st;
+    return stat(filename, &st) == 0 ? (long)st.st_size : -1;
+}
+
+void bench_person_block(void)
+{
+    Person *persons = bench_make_persons(BENCH_RECORDS);
+    if (!persons || !bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write %s\n", BENCH_FILE);
+        bench_free_persons(persons, BENCH_RECORDS);
+        return;
+    }
+
+    double start = bench_now();
+    PersonBlockWriter *w = person_block_writer_open(BENCH_BLOCK_FILE);
+    if (w) {
+        person_block_writer_append(w, persons, BENCH_RECORDS);
+        person_block_writer_close(w);
+    }
+    double write_time = bench_now() - start;
+    bench_free_persons(persons, BENCH_RECORDS);
+
+    printf("raw file:        %10ld bytes\n", file_size(BENCH_FILE));
+    printf("block file:      %10ld bytes (written at %.0f records/s)\n",
+           file_size(BENCH_BLOCK_FILE), BENCH_RECORDS / write_time);
+
+    // 1) raw format with read_person
+    size_t count = 0;
+    start = bench_now();
+    FILE *f = fopen(BENCH_FILE, "rb");
+    if (f) {
+        Person p = {0};
+        while (read_person(f, &p)) {
+            count++;
+            free_person(&p);
+        }
+        fclose(f);
+    }
+    double raw_time = bench_now() - start;
+    printf("read_person (raw):          %12.0f records/s (%zu records)\n", count / raw_time, count);
+
+    // 2) block format, decompressing block by block
+    count = 0;
+    start = bench_now();
+    PersonBlockReader r;
+    if (person_block_reader_open(&r, BENCH_BLOCK_FILE)) {
+        PersonView v;
+        while (person_block_reader_next(&r, &v))
+            count++;
+        person_block_reader_close(&r);
+    }
+    double block_time = bench_now() - start;
+    printf("person_block_reader (lz):   %12.0f records/s (%zu records)\n", count / block_time, count);
+
+    remove(BENCH_FILE);
+    remove(BENCH_BLOCK_FILE);
+}
@@ -0,0 +1,79 @@
+/*
+ * bench_person_mmap.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: read_person() loop (fread + malloc per record) against the
+ * memory-mapped zero-copy iterator.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "person_mmap.h"
+
+#define BENCH_FILE "bench_people.bin"
+
+void bench_person_mmap(void)
+{
+    if (!bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write %s\n", BENCH_FILE);
+        return;
+    }
+
+    // 1) read_person: two freads, a malloc and another fread per record
+    long long age_sum = 0, name_bytes = 0;
+    double start = bench_now();
+    FILE *f = fopen(BENCH_FILE, "rb");
+    if (f) {
+        Person p = {0};
+        while (read_person(f, &p)) {
+            age_sum += p.age;
+            name_bytes += p.name_len;
+            free_person(&p);
+        }
+        fclose(f);
+    }
+    double fread_time = bench_now() - start;
+    printf("read_person (fread+malloc): %12.0f records/s (ages=%lld, bytes=%lld)\n",
+           BENCH_RECORDS / fread_time, age_sum, name_bytes);
+
+    // 2) mmap iterator: pure memory scan
+    age_sum = 0;
+    name_bytes = 0;
+    start = bench_now();
+    PersonMap map;
+    if (person_map_open(BENCH_FILE, &map)) {
+        PersonMapIterator it;
+        PersonView v;
+        person_map_iter_init(&map, &it);
+        while (person_map_next(&it, &v)) {
+            age_sum += v.age;
+            name_bytes += v.name_len;
+        }
+        person_map_close(&map);
+    }
+    double mmap_time = bench_now() - start;
+    printf("person_map (mmap):          %12.0f records/s (ages=%lld, bytes=%lld)\n",
+           BENCH_RECORDS / mmap_time, age_sum, name_bytes);
+
+    remove(BENCH_FILE);
+}
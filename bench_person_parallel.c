@@ -0,0 +1,122 @@
+/*
+ * bench_person_parallel.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: parallel loading of a Person file with 1/2/4/8/16 threads, split
+ * at the index footer (fixed and varint records), against the one-thread load
+ * of a plain file. Decoding is mostly copying, so the load rate is compared
+ * with the memcpy bandwidth of one thread over the same number of bytes: once
+ * the threads together reach the memory bandwidth, more threads cannot help.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "bench.h"
+#include "person_writer.h"
+#include "person_parallel.h"
+#include "person_varint.h"
+
+#define BENCH_FILE         "bench_people.bin"
+#define BENCH_INDEXED_FILE "bench_people_indexed.bin"
+#define BENCH_VARINT_FILE  "bench_people_indexed_varint.bin"
+
+static void run(const char *label, const char *filename, int max_threads)
+{
+    static const int thread_counts[] = { 1, 2, 4, 8, 16 };
+
+    struct stat st;
+    double bytes = stat(filename, &st) == 0 ? (double)st.st_size : 0;
+
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        if (thread_counts[i] > max_threads) break;
+
+        PersonTable table;
+        if (!person_table_init(&table)) return;
+
+        double start = bench_now();
+        int ok = person_table_load_parallel(&table, filename, thread_counts[i]);
+        double elapsed = bench_now() - start;
+
+        printf("%-8s threads=%-2d %12.0f records/s %6.2f GB/s (%zu records%s)\n",
+               label, thread_counts[i], table.count / elapsed, bytes / elapsed * 1e-9,
+               table.count, ok ? "" : ", FAILED");
+        person_table_free(&table);
+    }
+}
+
+// memcpy of the indexed file, the bandwidth a single decoding thread competes for
+static void run_memcpy(const char *filename)
+{
+    struct stat st;
+    if (stat(filename, &st) != 0) return;
+    size_t size = (size_t)st.st_size;
+    char *from = malloc(size), *to = malloc(size);
+    if (from && to) {
+        // the first copy faults the pages in, the second one is timed
+        memset(from, 1, size);
+        memcpy(to, from, size);
+        from[0] = 2;
+        double start = bench_now();
+        memcpy(to, from, size);
+        double elapsed = bench_now() - start;
+        printf("memcpy   threads=1  %6.2f GB/s over %zu bytes (%ld CPUs online, check %d)\n",
+               size / elapsed * 1e-9, size, sysconf(_SC_NPROCESSORS_ONLN), to[size / 2]);
+    }
+    free(from);
+    free(to);
+}
+
+// write the persons with an index footer in the given encoding
+static int write_indexed(const char *filename, const Person *persons, uint8_t encoding)
+{
+    PersonWriter *w = person_writer_open_indexed(filename, 0);
+    int ok = w && person_writer_set_encoding(w, encoding) &&
+             person_writer_append(w, persons, BENCH_RECORDS);
+    if (w && !person_writer_close(w)) ok = 0;
+    return ok;
+}
+
+void bench_person_parallel(void)
+{
+    Person *persons = bench_make_persons(BENCH_RECORDS);
+    if (!persons || !write_indexed(BENCH_INDEXED_FILE, persons, PERSON_ENCODING_FIXED) ||
+        !write_indexed(BENCH_VARINT_FILE, persons, PERSON_ENCODING_VARINT) ||
+        !bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write the benchmark files\n");
+        bench_free_persons(persons, BENCH_RECORDS);
+        return;
+    }
+    bench_free_persons(persons, BENCH_RECORDS);
+
+    // without the footer only one thread can find the records
+    run("plain", BENCH_FILE, 1);
+    run("index", BENCH_INDEXED_FILE, 16);
+    run("varint", BENCH_VARINT_FILE, 16);
+    run_memcpy(BENCH_INDEXED_FILE);
+
+    remove(BENCH_FILE);
+    remove(BENCH_INDEXED_FILE);
+    remove(BENCH_VARINT_FILE);
+}
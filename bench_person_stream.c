@@ -0,0 +1,74 @@
+/*
+ * bench_person_stream.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: read_person() loop (stdio) against the double-buffered
+ * PersonStream with a background reader thread.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "person_stream.h"
+
+#define BENCH_FILE "bench_people.bin"
+
+void bench_person_stream(void)
+{
+    if (!bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write %s\n", BENCH_FILE);
+        return;
+    }
+
+    // 1) read_person over stdio
+    size_t count = 0;
+    double start = bench_now();
+    FILE *f = fopen(BENCH_FILE, "rb");
+    if (f) {
+        Person p = {0};
+        while (read_person(f, &p)) {
+            count++;
+            free_person(&p);
+        }
+        fclose(f);
+    }
+    double fread_time = bench_now() - start;
+    printf("read_person (stdio):        %12.0f records/s (%zu records)\n",
+           count / fread_time, count);
+
+    // 2) double-buffered stream
+    count = 0;
+    start = bench_now();
+    PersonStream s;
+    if (person_stream_open(&s, BENCH_FILE, 0)) {
+        Person p = {0};
+        while (person_stream_next(&s, &p)) {
+            count++;
+            free_person(&p);
+        }
+        person_stream_close(&s);
+    }
+    double stream_time = bench_now() - start;
+    printf("person_stream (2 buffers):  %12.0f records/s (%zu records)\n",
+           count / stream_time, count);
+
+    remove(BENCH_FILE);
+}
@@ -0,0 +1,100 @@
+/*
+ * bench_person_table.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: age scans over an array of Person structures (AoS) against the
+ * columnar PersonTable (SoA).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "person_table.h"
+
+#define BENCH_FILE "bench_people.bin"
+#define BENCH_REPEAT 20
+
+void bench_person_table(void)
+{
+    if (!bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write %s\n", BENCH_FILE);
+        return;
+    }
+
+    Person *persons = bench_make_persons(BENCH_RECORDS);
+    PersonTable table;
+    if (!persons || !person_table_init(&table) || !person_table_load(&table, BENCH_FILE)) {
+        printf("could not load %s\n", BENCH_FILE);
+        bench_free_persons(persons, BENCH_RECORDS);
+        remove(BENCH_FILE);
+        return;
+    }
+
+    // 1) AoS: count persons aged 18..65 and min/max age
+    size_t aos_count = 0;
+    int32_t lo = 0, hi = 0;
+    double start = bench_now();
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+        aos_count = 0;
+        lo = persons[0].age;
+        hi = persons[0].age;
+        for (size_t i = 0; i < BENCH_RECORDS; i++) {
+            if (persons[i].age >= 18 && persons[i].age <= 65) aos_count++;
+            if (persons[i].age < lo) lo = persons[i].age;
+            if (persons[i].age > hi) hi = persons[i].age;
+        }
+    }
+    double aos_time = bench_now() - start;
+
+    // 2) SoA: the same with the table kernels
+    size_t soa_count = 0;
+    start = bench_now();
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+        soa_count = person_table_count_age(&table, 18, 65);
+        person_table_age_min_max(&table, &lo, &hi);
+    }
+    double soa_time = bench_now() - start;
+
+    printf("AoS count+min/max:  %12.0f rows/s (count=%zu)\n",
+           BENCH_REPEAT * (double)BENCH_RECORDS / aos_time, aos_count);
+    printf("SoA count+min/max:  %12.0f rows/s (count=%zu, min=%d, max=%d)\n",
+           BENCH_REPEAT * (double)BENCH_RECORDS / soa_time, soa_count, lo, hi);
+
+    // 3) histogram and filter on the table
+    uint64_t bins[128];
+    uint32_t *selection = malloc(table.count * sizeof(uint32_t));
+    size_t selected = 0;
+    start = bench_now();
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+        if (!person_table_age_histogram(&table, bins, 128)) break;
+        if (selection) selected = person_table_filter_age(&table, 18, 65, selection);
+    }
+    double rest_time = bench_now() - start;
+    printf("SoA histogram+filter: %10.0f rows/s (bin[18]=%llu, selected=%zu)\n",
+           BENCH_REPEAT * (double)BENCH_RECORDS / rest_time,
+           (unsigned long long)bins[18], selected);
+
+    free(selection);
+    person_table_free(&table);
+    bench_free_persons(persons, BENCH_RECORDS);
+    remove(BENCH_FILE);
+}
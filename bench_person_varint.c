@@ -0,0 +1,247 @@
+/*
+ * bench_person_varint.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: file size and scan speed of the fixed 8-byte record header
+ * against the varint encoding, with the files in the page cache (warm) and
+ * read from disk (cold). Warm, the fixed header is faster to decode; cold,
+ * the smaller varint file has less to read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "bench.h"
+#include "arena.h"
+#include "person_index.h"
+#include "person_mmap.h"
+#include "person_parallel.h"
+#include "person_stream.h"
+#include "person_table.h"
+#include "person_varint.h"
+#include "person_writer.h"
+
+#define BENCH_FILE        "bench_people.bin"
+#define BENCH_VARINT_FILE "bench_people_varint.bin"
+#define BENCH_CHECK_FILE  "bench_people_check.bin"
+#define BENCH_BATCH       1024
+#define BENCH_CHECK_COUNT 1000
+
+// 1 if the record equals persons[i]
+static int same_person(const Person *persons, size_t i, int32_t age, const char *name, uint32_t name_len)
+{
+    return i < BENCH_CHECK_COUNT && persons[i].age == age && persons[i].name_len == name_len &&
+           memcmp(persons[i].name, name, name_len) == 0;
+}
+
+// Drop a file from the page cache, so that the next scan reads it from disk
+static void evict(const char *filename)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+// Fixed headers through the mmap iterator, returns the seconds taken
+static double scan_fixed(const char *filename, size_t *count, long long *age_sum)
+{
+    double start = bench_now();
+    PersonMap map;
+    if (person_map_open(filename, &map)) {
+        PersonMapIterator it;
+        PersonView v;
+        person_map_iter_init(&map, &it);
+        while (person_map_next(&it, &v)) {
+            *age_sum += v.age;
+            (*count)++;
+        }
+        person_map_close(&map);
+    }
+    return bench_now() - start;
+}
+
+// Varint headers, decoded in batches, returns the seconds taken
+static double scan_varint(const char *filename, size_t *count, long long *age_sum)
+{
+    PersonView views[BENCH_BATCH];
+    double start = bench_now();
+    PersonMap map;
+    if (person_map_open(filename, &map)) {
+        size_t position = map.records_start, used, n;
+        while ((n = person_varint_decode_views(map.data + position, map.records_size - position,
+                                               views, BENCH_BATCH, &used)) > 0) {
+            for (size_t i = 0; i < n; i++)
+                *age_sum += views[i].age;
+            *count += n;
+            position += used;
+        }
+        person_map_close(&map);
+    }
+    return bench_now() - start;
+}
+
+/*
+ * check_readers - write the persons in one format (version 1 when encoding
+ * is -1) and read them back with every reader
+ * Returns: 1 if every reader returned all persons unchanged
+ */
+static int check_readers(const Person *persons, int encoding)
+{
+    PersonWriter *w = person_writer_open_indexed(BENCH_CHECK_FILE, 64);
+    int ok = w && (encoding < 0 || person_writer_set_encoding(w, (uint8_t)encoding)) &&
+             person_writer_append(w, persons, BENCH_CHECK_COUNT);
+    if (w && !person_writer_close(w)) ok = 0;
+    if (!ok) return 0;
+
+    // PersonMap
+    PersonMap map;
+    size_t n = 0;
+    if (!person_map_open(BENCH_CHECK_FILE, &map)) return 0;
+    PersonMapIterator it;
+    PersonView v;
+    person_map_iter_init(&map, &it);
+    while (person_map_next(&it, &v))
+        if (!same_person(persons, n++, v.age, v.name, v.name_len)) ok = 0;
+    person_map_close(&map);
+    if (n != BENCH_CHECK_COUNT) ok = 0;
+
+    // PersonTable, sequential and parallel
+    for (int parallel = 0; parallel < 2; parallel++) {
+        PersonTable t;
+        if (!person_table_init(&t)) return 0;
+        if (!(parallel ? person_table_load_parallel(&t, BENCH_CHECK_FILE, 3)
+                       : person_table_load(&t, BENCH_CHECK_FILE)) || t.count != BENCH_CHECK_COUNT) ok = 0;
+        for (size_t i = 0; i < t.count; i++) {
+            uint32_t name_len;
+            const char *name = person_table_name(&t, i, &name_len);
+            if (!same_person(persons, i, t.ages[i], name, name_len)) ok = 0;
+        }
+        person_table_free(&t);
+    }
+
+    // arena loader
+    Arena arena;
+    arena_init(&arena, 0);
+    Person *loaded = load_persons_arena(BENCH_CHECK_FILE, &arena, &n);
+    if (!loaded || n != BENCH_CHECK_COUNT) ok = 0;
+    for (size_t i = 0; loaded && i < n; i++)
+        if (!same_person(persons, i, loaded[i].age, loaded[i].name, loaded[i].name_len)) ok = 0;
+    free(loaded);
+    arena_free(&arena);
+
+    // read_person_at through the index footer
+    FILE *f = fopen(BENCH_CHECK_FILE, "rb");
+    if (!f) return 0;
+    PersonIndex *index = person_index_open(f);
+    if (!index || index->count != BENCH_CHECK_COUNT) ok = 0;
+    for (size_t i = BENCH_CHECK_COUNT; index && i-- > 0; ) {
+        Person p = {0};
+        if (!read_person_at(index, i, &p) || !same_person(persons, i, p.age, p.name, p.name_len)) ok = 0;
+        free_person(&p);
+    }
+    person_index_close(index);
+    fclose(f);
+
+    // PersonStream, with buffers smaller than some records
+    PersonStream stream;
+    n = 0;
+    if (!person_stream_open(&stream, BENCH_CHECK_FILE, 64)) return 0;
+    Person p = {0};
+    while (person_stream_next(&stream, &p)) {
+        if (!same_person(persons, n++, p.age, p.name, p.name_len)) ok = 0;
+        free_person(&p);
+    }
+    person_stream_close(&stream);
+    if (n != BENCH_CHECK_COUNT) ok = 0;
+
+    remove(BENCH_CHECK_FILE);
+    return ok;
+}
+
+void bench_person_varint(void)
+{
+    // every reader must understand every format; negative ages and a name
+    // longer than the writer and stream buffers take the unusual paths
+    Person *check = bench_make_persons(BENCH_CHECK_COUNT);
+    if (check) {
+        char *long_name = realloc(check[7].name, 300);
+        if (long_name) {
+            memset(long_name, 'x', 300);
+            check[7].name = long_name;
+            check[7].name_len = 300;
+        }
+        for (size_t i = 0; i < BENCH_CHECK_COUNT; i += 3) check[i].age = -check[i].age * 1000;
+        printf("round trip: version 1 %s, fixed %s, varint %s\n",
+               check_readers(check, -1) ? "ok" : "FAILED",
+               check_readers(check, PERSON_ENCODING_FIXED) ? "ok" : "FAILED",
+               check_readers(check, PERSON_ENCODING_VARINT) ? "ok" : "FAILED");
+        bench_free_persons(check, BENCH_CHECK_COUNT);
+    }
+
+    Person *persons = bench_make_persons(BENCH_RECORDS);
+    FILE *f = fopen(BENCH_VARINT_FILE, "wb");
+    if (!persons || !f || !bench_write_people_file(BENCH_FILE, BENCH_RECORDS)) {
+        printf("could not write the benchmark files\n");
+        if (f) fclose(f);
+        bench_free_persons(persons, BENCH_RECORDS);
+        return;
+    }
+
+    person_file_write_header(f, PERSON_ENCODING_VARINT);
+    for (size_t i = 0; i < BENCH_RECORDS; i++)
+        write_person_encoded(f, &persons[i], PERSON_ENCODING_VARINT);
+    fclose(f);
+    bench_free_persons(persons, BENCH_RECORDS);
+
+    struct stat fixed_st, varint_st;
+    stat(BENCH_FILE, &fixed_st);
+    stat(BENCH_VARINT_FILE, &varint_st);
+    printf("fixed file:  %10ld bytes\n", (long)fixed_st.st_size);
+    printf("varint file: %10ld bytes\n", (long)varint_st.st_size);
+
+    // warm: both files are still in the page cache from writing them;
+    // cold: dropped from the page cache first, so the scan reads the disk
+    for (int cold = 0; cold < 2; cold++) {
+        const char *label = cold ? "cold" : "warm";
+        long long age_sum = 0;
+        size_t count = 0;
+        if (cold) evict(BENCH_FILE);
+        double time = scan_fixed(BENCH_FILE, &count, &age_sum);
+        printf("fixed scan  (%s): %12.0f records/s (%zu records, ages=%lld)\n",
+               label, count / time, count, age_sum);
+
+        age_sum = 0;
+        count = 0;
+        if (cold) evict(BENCH_VARINT_FILE);
+        time = scan_varint(BENCH_VARINT_FILE, &count, &age_sum);
+        printf("varint scan (%s): %12.0f records/s (%zu records, ages=%lld)\n",
+               label, count / time, count, age_sum);
+    }
+
+    remove(BENCH_FILE);
+    remove(BENCH_VARINT_FILE);
+}
@@ -0,0 +1,66 @@
+/*
+ * bench_person_writer.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: write_person() loop (the write_persons_to_file path) against
+ * the batched PersonWriter.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "person_writer.h"
+
+#define BENCH_FILE "bench_people.bin"
+
+void bench_person_writer(void)
+{
+    Person *persons = bench_make_persons(BENCH_RECORDS);
+    if (!persons) {
+        printf("could not allocate persons\n");
+        return;
+    }
+
+    // 1) the current path: one write_person (three fwrite calls) per record
+    double start = bench_now();
+    FILE *f = fopen(BENCH_FILE, "wb");
+    if (f) {
+        for (size_t i = 0; i < BENCH_RECORDS; i++)
+            write_person(f, &persons[i]);
+        fclose(f);
+    }
+    double fwrite_time = bench_now() - start;
+
+    // 2) batched writer: one write per buffer
+    start = bench_now();
+    PersonWriter *w = person_writer_open(BENCH_FILE, 0);
+    if (w) {
+        person_writer_append(w, persons, BENCH_RECORDS);
+        person_writer_close(w);
+    }
+    double batch_time = bench_now() - start;
+
+    printf("write_person (fwrite x3):  %12.0f records/s\n", BENCH_RECORDS / fwrite_time);
+    printf("person_writer (batched):   %12.0f records/s\n", BENCH_RECORDS / batch_time);
+
+    remove(BENCH_FILE);
+    bench_free_persons(persons, BENCH_RECORDS);
+}
@@ -0,0 +1,99 @@
+/*
+ * bench_shard_runtime.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: throughput of the sharded runtime with 1/2/4/8/16 threads.
+ * The first quarter of the instances starts in STATE_MOVING, whose guard is
+ * expensive, so those shards are slower and work stealing has to balance them.
+ * The work is compute bound (the guards), so the throughput grows with the
+ * threads up to the number of cores; beyond that the threads only take turns.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include "bench.h"
+#include "shard_runtime.h"
+
+#define BENCH_INSTANCES 1000000
+#define BENCH_SHARD     4096
+#define BENCH_STEPS     20
+
+// guards must be thread-safe, so the counters are per thread
+static _Thread_local unsigned start_calls, stop_calls;
+
+static bool bench_start_moving(void)
+{
+    return (++start_calls & 3) == 0;
+}
+
+// expensive guard: some work before the (rare) decision
+static bool bench_stop_moving(void)
+{
+    volatile unsigned work = 0;
+    for (int i = 0; i < 32; i++) work += i;
+    return (++stop_calls & 15) == 0;
+}
+
+static const Transition bench_table[] = {
+    { STATE_INIT,   NULL,               STATE_STILL },
+    { STATE_STILL,  bench_start_moving, STATE_MOVING },
+    { STATE_MOVING, bench_stop_moving,  STATE_STILL },
+};
+
+void bench_shard_runtime(void)
+{
+    static const int thread_counts[] = { 0, 1, 2, 4, 8, 16 };
+    size_t count = sizeof(bench_table) / sizeof(bench_table[0]);
+    double single = 0;
+
+    printf("%ld cores online\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        ShardRuntime r;
+        if (!shard_runtime_init(&r, bench_table, count, STATE_COUNT, BENCH_INSTANCES,
+                                BENCH_SHARD, thread_counts[t], STATE_INIT))
+            return;
+
+        // skew: the first quarter of the instances is busy
+        for (size_t i = 0; i < BENCH_INSTANCES / 4; i++) {
+            size_t local;
+            StateEngine *shard = shard_runtime_shard(&r, i, &local);
+            shard->states[local] = STATE_MOVING;
+        }
+
+        double start = bench_now();
+        shard_runtime_run(&r, BENCH_STEPS);
+        double elapsed = bench_now() - start;
+
+        if (thread_counts[t] == 0)
+            printf("deterministic   ");
+        else
+            printf("threads=%-2d      ", thread_counts[t]);
+        double rate = (double)BENCH_INSTANCES * BENCH_STEPS / elapsed;
+        if (thread_counts[t] == 1) single = rate;
+        printf("%12.0f instance-steps/s", rate);
+        if (single > 0) printf(" (x%.2f)", rate / single);
+        printf(" (%zu shards stolen)\n", shard_runtime_stolen(&r));
+
+        shard_runtime_free(&r);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * bench_state_dispatch.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: the function-pointer loop (transition_table_step) against the
+ * switch generated from the same X-macro transition list.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "bench.h"
+
+#define BENCH_STEPS 50000000
+
+/* Synthetic guards: cheap pseudo-random decisions (xorshift),
+   so the step itself dominates, not the guard */
+static uint32_t guard_seed = 2463534242u;
+
+static inline uint32_t guard_random(void)
+{
+    guard_seed ^= guard_seed << 13;
+    guard_seed ^= guard_seed >> 17;
+    guard_seed ^= guard_seed << 5;
+    return guard_seed;
+}
+
+static bool guard_start(void) { return (guard_random() & 1) == 0; }
+static bool guard_stop(void)  { return (guard_random() & 3) == 0; }
+static bool guard_halt(void)  { return (guard_random() & 15) == 0; }
+
+/* The benchmark machine, defined once; STOP restarts so it runs forever */
+#define BENCH_TRANSITIONS(T)            \
+    T(INIT,   NULL,        STILL)       \
+    T(STILL,  guard_start, MOVING)      \
+    T(MOVING, guard_halt,  STOP)        \
+    T(MOVING, guard_stop,  STILL)       \
+    T(STOP,   NULL,        INIT)
+
+static const Transition bench_table[] = {
+    BENCH_TRANSITIONS(TRANSITION_ROW)
+};
+
+DEFINE_TRANSITION_DISPATCH(bench_dispatch, BENCH_TRANSITIONS)
+
+void bench_state_dispatch(void)
+{
+    const size_t count = sizeof(bench_table) / sizeof(bench_table[0]);
+    uint64_t visits[STATE_COUNT] = {0};
+
+    // 1) runtime table: loop over the rows, guards called through pointers
+    guard_seed = 2463534242u;
+    State state = STATE_INIT;
+    double start = bench_now();
+    for (size_t i = 0; i < BENCH_STEPS; i++) {
+        state = transition_table_step(bench_table, count, state);
+        visits[state]++;
+    }
+    double table_time = bench_now() - start;
+    State table_state = state;
+    uint64_t table_stops = visits[STATE_STOP];
+
+    // 2) generated switch: jump table on the state, guards called directly
+    guard_seed = 2463534242u;
+    visits[STATE_STOP] = 0;
+    state = STATE_INIT;
+    start = bench_now();
+    for (size_t i = 0; i < BENCH_STEPS; i++) {
+        state = bench_dispatch(state);
+        visits[state]++;
+    }
+    double dispatch_time = bench_now() - start;
+
+    printf("function-pointer table: %12.0f steps/s (%.2f ns/step)\n",
+           BENCH_STEPS / table_time, table_time * 1e9 / BENCH_STEPS);
+    printf("generated dispatch:     %12.0f steps/s (%.2f ns/step)\n",
+           BENCH_STEPS / dispatch_time, dispatch_time * 1e9 / BENCH_STEPS);
+
+    // both runs must walk the same path
+    if (state != table_state || visits[STATE_STOP] != table_stops)
+        printf("MISMATCH: table ended in %s, dispatch in %s\n",
+               state_name(table_state), state_name(state));
+}
@@ -0,0 +1,95 @@
+/*
+ * bench_state_engine.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: stepping many state machine instances one by one against the
+ * batched StateEngine (with per-instance guards and with a batch guard).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "state_engine.h"
+
+#define BENCH_STATES    16
+#define BENCH_PER_STATE 4
+#define BENCH_INSTANCES 1000000
+#define BENCH_STEPS     10
+
+static void report(const char *label, double seconds)
+{
+    printf("%-28s %12.0f instance-steps/s\n", label,
+           (double)BENCH_INSTANCES * BENCH_STEPS / seconds);
+}
+
+void bench_state_engine(void)
+{
+    size_t count;
+    Transition *table = bench_make_transitions(BENCH_STATES, BENCH_PER_STATE, &count);
+    State *states = malloc(BENCH_INSTANCES * sizeof(State));
+    TransitionIndex index;
+    if (!table || !states || !transition_index_build(&index, table, count, BENCH_STATES)) {
+        free(table);
+        free(states);
+        return;
+    }
+
+    // 1) one transition_table_step call per instance
+    for (size_t i = 0; i < BENCH_INSTANCES; i++) states[i] = STATE_INIT;
+    double start = bench_now();
+    for (int s = 0; s < BENCH_STEPS; s++)
+        for (size_t i = 0; i < BENCH_INSTANCES; i++)
+            states[i] = transition_table_step(table, count, states[i]);
+    report("per instance, linear scan", bench_now() - start);
+
+    // 2) one transition_index_step call per instance
+    for (size_t i = 0; i < BENCH_INSTANCES; i++) states[i] = STATE_INIT;
+    start = bench_now();
+    for (int s = 0; s < BENCH_STEPS; s++)
+        for (size_t i = 0; i < BENCH_INSTANCES; i++)
+            states[i] = transition_index_step(&index, states[i]);
+    report("per instance, index", bench_now() - start);
+
+    // 3) engine, scalar guard called per instance inside the groups
+    StateEngine engine;
+    if (state_engine_init(&engine, table, count, BENCH_STATES, BENCH_INSTANCES, STATE_INIT)) {
+        start = bench_now();
+        for (int s = 0; s < BENCH_STEPS; s++)
+            state_engine_step(&engine);
+        report("engine, scalar guards", bench_now() - start);
+        state_engine_free(&engine);
+    }
+
+    // 4) engine with the batch guard
+    if (state_engine_init(&engine, table, count, BENCH_STATES, BENCH_INSTANCES, STATE_INIT)) {
+        state_engine_set_batch_guard(&engine, bench_guard_rare, bench_guard_rare_batch, NULL);
+        start = bench_now();
+        for (int s = 0; s < BENCH_STEPS; s++)
+            state_engine_step(&engine);
+        report("engine, batch guards", bench_now() - start);
+        state_engine_free(&engine);
+    }
+
+    transition_index_free(&index);
+    free(states);
+    free(table);
+}
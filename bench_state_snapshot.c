@@ -0,0 +1,135 @@
+/*
+ * bench_state_snapshot.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: full and delta snapshots of a million-instance StateEngine -
+ * how long stepping pauses for the capture, the file write (which can run on
+ * another thread) and the restore through mmap. The second full snapshot is
+ * the first one merged with the delta, so stepping only pauses for the delta.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+#include "state_snapshot.h"
+
+#define BENCH_INSTANCES 1000000
+#define BENCH_FULL_FILE   "bench_full.snap"
+#define BENCH_DELTA_FILE  "bench_delta.snap"
+#define BENCH_MERGED_FILE "bench_merged.snap"
+
+// about one instance in 64 changes state per step
+static unsigned snapshot_calls = 0;
+static bool guard_seldom(void) { return (++snapshot_calls & 63) == 0; }
+
+void bench_state_snapshot(void)
+{
+    static const Transition table[] = {
+        { STATE_INIT,   NULL,         STATE_STILL },
+        { STATE_STILL,  guard_seldom, STATE_MOVING },
+        { STATE_MOVING, guard_seldom, STATE_STILL },
+    };
+    static const TimedTransition timed[] = {
+        { STATE_MOVING, 100, STATE_STILL },
+    };
+
+    StateEngine engine, restored;
+    uint32_t *data = calloc(BENCH_INSTANCES, sizeof(uint32_t));
+    if (!data || !state_engine_init(&engine, table, 3, STATE_COUNT, BENCH_INSTANCES, STATE_INIT)) {
+        free(data);
+        return;
+    }
+    state_engine_set_timeouts(&engine, timed, 1);
+    state_engine_track_changes(&engine);
+    state_engine_step(&engine);
+
+    // 1) full snapshot, kept by the writer for the merge
+    StateSnapshot full, s;
+    double start = bench_now();
+    int ok = state_snapshot_capture(&full, &engine, data, sizeof(uint32_t), STATE_SNAPSHOT_FULL);
+    double capture = bench_now() - start;
+    start = bench_now();
+    ok = ok && state_snapshot_write(&full, BENCH_FULL_FILE);
+    double write = bench_now() - start;
+    printf("full:  %8zu records, capture %7.2f ms, write %7.2f ms\n",
+           (size_t)full.header.record_count, capture * 1e3, write * 1e3);
+
+    // 2) one step later only the changed instances are in the delta
+    state_engine_step(&engine);
+    state_engine_tick(&engine);
+    data[7]++;
+    state_engine_mark_dirty(&engine, 7);
+    start = bench_now();
+    ok = ok && state_snapshot_capture(&s, &engine, data, sizeof(uint32_t), STATE_SNAPSHOT_DELTA);
+    capture = bench_now() - start;
+    start = bench_now();
+    ok = ok && state_snapshot_write(&s, BENCH_DELTA_FILE);
+    write = bench_now() - start;
+    printf("delta: %8zu records, capture %7.2f ms, write %7.2f ms\n",
+           (size_t)s.header.record_count, capture * 1e3, write * 1e3);
+
+    // 3) the next full snapshot without a full capture: merge the delta (writer side)
+    start = bench_now();
+    ok = ok && state_snapshot_merge(&full, &s);
+    double merge = bench_now() - start;
+    start = bench_now();
+    ok = ok && state_snapshot_write(&full, BENCH_MERGED_FILE);
+    write = bench_now() - start;
+    printf("full by merge: %8zu records, stepping paused only for the delta, merge %7.2f ms, write %7.2f ms\n",
+           (size_t)full.header.record_count, merge * 1e3, write * 1e3);
+    state_snapshot_free(&s);
+    state_snapshot_free(&full);
+
+    // 4) restore full + delta, and the merged full alone, into fresh engines
+    static const char *const files[][2] = {
+        { BENCH_FULL_FILE, BENCH_DELTA_FILE },
+        { BENCH_MERGED_FILE, NULL },
+    };
+    uint32_t *restored_data = calloc(BENCH_INSTANCES, sizeof(uint32_t));
+    for (int k = 0; k < 2 && ok && restored_data; k++) {
+        if (!state_engine_init(&restored, table, 3, STATE_COUNT, BENCH_INSTANCES, STATE_INIT)) break;
+        state_engine_set_timeouts(&restored, timed, 1);
+        start = bench_now();
+        int restored_ok = state_snapshot_restore(&restored, restored_data, sizeof(uint32_t), files[k][0]) &&
+                          (!files[k][1] ||
+                           state_snapshot_restore(&restored, restored_data, sizeof(uint32_t), files[k][1]));
+        double restore = bench_now() - start;
+
+        size_t different = 0;
+        for (size_t i = 0; i < BENCH_INSTANCES; i++)
+            different += restored.states[i] != engine.states[i] || restored_data[i] != data[i] ||
+                         timer_wheel_remaining(&restored.timers, (uint32_t)i) !=
+                         timer_wheel_remaining(&engine.timers, (uint32_t)i);
+        printf("restore %-13s %7.2f ms (%s, %zu instances differ)\n",
+               files[k][1] ? "full + delta:" : "merged full:", restore * 1e3,
+               restored_ok ? "ok" : "failed", different);
+        state_engine_free(&restored);
+    }
+    free(restored_data);
+
+    state_engine_free(&engine);
+    free(data);
+    unlink(BENCH_FULL_FILE);
+    unlink(BENCH_DELTA_FILE);
+    unlink(BENCH_MERGED_FILE);
+}
@@ -0,0 +1,337 @@
+/*
+ * bench_state_suite.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * State machine benchmark suite (make bench-states).
+ * Runs the demo machine (DEMO_TRANSITIONS with the suite's own synthetic
+ * guards) as a table and as the generated dispatch, the table scan and
+ * index over synthetic tables, and the batched engine, over several table
+ * sizes and instance counts. Reports steps/s,
+ * ns/step percentiles (over batches of steps) and, when perf_event_open is
+ * allowed, cache and branch misses per step. The same numbers are written
+ * as CSV to bench_states.csv (or $BENCH_STATES_CSV) for regression tracking.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "bench.h"
+#include "state_machine.h"
+#include "transition_index.h"
+#include "state_engine.h"
+
+#define SUITE_BATCH       256       // steps per timing sample
+#define SUITE_SECONDS     0.2       // time per configuration
+#define SUITE_MAX_SAMPLES 100000
+
+typedef struct {
+    const char *machine;
+    size_t      states;
+    size_t      transitions;
+    size_t      instances;
+} SuiteConfig;
+
+typedef struct {
+    int       cache_fd;             // -1 = not available
+    int       branch_fd;
+    double   *samples;              // ns/step of every batch
+    FILE     *csv;
+} Suite;
+
+/* ---- perf_event_open counters ---- */
+
+static int perf_open(uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void perf_start(int fd)
+{
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+// Returns the counter value, or -1 when the counter is not available
+static long long perf_stop(int fd)
+{
+    uint64_t value;
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    return read(fd, &value, sizeof(value)) == sizeof(value) ? (long long)value : -1;
+}
+
+/* ---- synthetic guards for the demo machines ---- */
+
+static uint32_t guard_seed = 2463534242u;
+
+static inline uint32_t guard_random(void)
+{
+    guard_seed ^= guard_seed << 13;
+    guard_seed ^= guard_seed >> 17;
+    guard_seed ^= guard_seed << 5;
+    return guard_seed;
+}
+
+static bool suite_start_moving(void) { return (guard_random() & 1) == 0; }
+static bool suite_stop_moving(void)  { return (guard_random() & 3) == 0; }
+static bool suite_shutdown(void)     { return (guard_random() & 63) == 0; }
+
+/* The demo machine with these guards: the DEMO_TRANSITIONS list of
+   state_machine.h, with every guard g replaced by suite_g (NULL stays NULL) */
+#define suite_NULL NULL
+#define SUITE_TRANSITION_ROW(from, guard, to)          TRANSITION_ROW(from, suite_##guard, to)
+#define SUITE_TRANSITION_DISPATCH_ROW(from, guard, to) TRANSITION_DISPATCH_ROW(from, suite_##guard, to)
+#define SUITE_TRANSITIONS(T)                           DEMO_TRANSITIONS(SUITE_##T)
+
+static const Transition suite_transitions[] = {
+    SUITE_TRANSITIONS(TRANSITION_ROW)
+};
+
+#define SUITE_TRANSITION_COUNT (sizeof(suite_transitions) / sizeof(suite_transitions[0]))
+
+DEFINE_TRANSITION_DISPATCH(suite_dispatch, SUITE_TRANSITIONS)
+
+/* ---- reporting ---- */
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, size_t count, double p)
+{
+    size_t i = (size_t)(p * (count - 1) + 0.5);
+    return sorted[i];
+}
+
+static void report(Suite *suite, const SuiteConfig *c, uint64_t steps, double seconds,
+                   size_t samples, long long cache_misses, long long branch_misses)
+{
+    if (samples == 0 || steps == 0) return;
+    qsort(suite->samples, samples, sizeof(double), compare_double);
+
+    double p50 = percentile(suite->samples, samples, 0.50);
+    double p90 = percentile(suite->samples, samples, 0.90);
+    double p99 = percentile(suite->samples, samples, 0.99);
+    double max = suite->samples[samples - 1];
+
+    printf("%-10s %6zu %7zu %8zu %12.0f %8.2f %8.2f %8.2f %9.2f",
+           c->machine, c->states, c->transitions, c->instances, steps / seconds, p50, p90, p99, max);
+    if (cache_misses >= 0) printf(" %8.3f", (double)cache_misses / steps);
+    else printf(" %8s", "n/a");
+    if (branch_misses >= 0) printf(" %8.3f\n", (double)branch_misses / steps);
+    else printf(" %8s\n", "n/a");
+
+    if (suite->csv) {
+        fprintf(suite->csv, "%s,%zu,%zu,%zu,%llu,%.0f,%.3f,%.3f,%.3f,%.3f,",
+                c->machine, c->states, c->transitions, c->instances, (unsigned long long)steps,
+                steps / seconds, p50, p90, p99, max);
+        if (cache_misses >= 0) fprintf(suite->csv, "%.4f", (double)cache_misses / steps);
+        fprintf(suite->csv, ",");
+        if (branch_misses >= 0) fprintf(suite->csv, "%.4f", (double)branch_misses / steps);
+        fprintf(suite->csv, "\n");
+    }
+}
+
+/* ---- one configuration ---- */
+
+// the step being measured; with a constant step the compiler inlines it into suite_run
+typedef State (*SuiteStep)(const void *context, State state);
+
+/*
+ * suite_run - step instances round-robin in batches of SUITE_BATCH until the time is up
+ * @states, @count: the instances' states
+ */
+static inline __attribute__((always_inline))
+void suite_run(Suite *suite, const SuiteConfig *c, State *states, size_t count,
+               SuiteStep step, const void *context)
+{
+    size_t cursor = 0, samples = 0;
+    uint64_t steps = 0;
+
+    perf_start(suite->cache_fd);
+    perf_start(suite->branch_fd);
+    double begin = bench_now(), last = begin;
+
+    while (samples < SUITE_MAX_SAMPLES && last - begin < SUITE_SECONDS) {
+        for (int k = 0; k < SUITE_BATCH; k++) {
+            states[cursor] = step(context, states[cursor]);
+            if (++cursor == count) cursor = 0;
+        }
+        double now = bench_now();
+        suite->samples[samples++] = (now - last) * 1e9 / SUITE_BATCH;
+        steps += SUITE_BATCH;
+        last = now;
+    }
+
+    long long cache_misses = perf_stop(suite->cache_fd);
+    long long branch_misses = perf_stop(suite->branch_fd);
+    report(suite, c, steps, last - begin, samples, cache_misses, branch_misses);
+}
+
+// the demo machines stop in STATE_STOP; the benchmark starts them again
+static inline State restart(State s) { return s == STATE_STOP ? STATE_INIT : s; }
+
+static State step_table(const void *context, State s)
+{
+    (void)context;
+    return restart(transition_table_step(suite_transitions, SUITE_TRANSITION_COUNT, s));
+}
+
+static State step_compiled(const void *context, State s) { (void)context; return restart(suite_dispatch(s)); }
+
+typedef struct {
+    const Transition *table;
+    size_t            count;
+} TableContext;
+
+static State step_scan(const void *context, State s)
+{
+    const TableContext *t = context;
+    return transition_table_step(t->table, t->count, s);
+}
+
+static State step_index(const void *context, State s)
+{
+    return transition_index_step(context, s);
+}
+
+/* The engine steps all instances at once; one sample = one engine step */
+static void suite_run_engine(Suite *suite, const SuiteConfig *c, const Transition *table)
+{
+    StateEngine engine;
+    if (!state_engine_init(&engine, table, c->transitions, c->states, c->instances, STATE_INIT)) return;
+
+    size_t samples = 0;
+    perf_start(suite->cache_fd);
+    perf_start(suite->branch_fd);
+    double begin = bench_now(), last = begin;
+
+    while (samples < SUITE_MAX_SAMPLES && last - begin < SUITE_SECONDS) {
+        state_engine_step(&engine);
+        double now = bench_now();
+        suite->samples[samples++] = (now - last) * 1e9 / c->instances;
+        last = now;
+    }
+
+    long long cache_misses = perf_stop(suite->cache_fd);
+    long long branch_misses = perf_stop(suite->branch_fd);
+    report(suite, c, (uint64_t)samples * c->instances, last - begin, samples, cache_misses, branch_misses);
+    state_engine_free(&engine);
+}
+
+static State *fresh_states(State *states, size_t count)
+{
+    for (size_t i = 0; i < count; i++) states[i] = STATE_INIT;
+    return states;
+}
+
+void bench_state_suite(void)
+{
+    static const size_t instance_counts[] = { 1, 1024, 1000000 };
+    static const size_t table_sizes[][2] = { { 16, 4 }, { 256, 4 }, { 4096, 4 } };   // states, per state
+    const size_t max_instances = 1000000;
+
+    Suite suite;
+    suite.samples = malloc(SUITE_MAX_SAMPLES * sizeof(double));
+    State *states = malloc(max_instances * sizeof(State));
+    if (!suite.samples || !states) {
+        free(suite.samples);
+        free(states);
+        return;
+    }
+
+    suite.cache_fd = perf_open(PERF_COUNT_HW_CACHE_MISSES);
+    suite.branch_fd = perf_open(PERF_COUNT_HW_BRANCH_MISSES);
+    if (suite.cache_fd < 0 || suite.branch_fd < 0)
+        printf("(perf_event_open not available - no miss counters)\n");
+
+    const char *csv_name = getenv("BENCH_STATES_CSV");
+    if (!csv_name) csv_name = "bench_states.csv";
+    suite.csv = fopen(csv_name, "w");
+    if (suite.csv)
+        fprintf(suite.csv, "machine,states,transitions,instances,steps,steps_per_sec,"
+                           "ns_p50,ns_p90,ns_p99,ns_max,cache_misses_per_step,branch_misses_per_step\n");
+    else
+        perror("Failed to open file");
+
+    printf("%-10s %6s %7s %8s %12s %8s %8s %8s %9s %8s %8s\n", "machine", "states", "trans",
+           "inst", "steps/s", "p50 ns", "p90 ns", "p99 ns", "max ns", "cmiss", "bmiss");
+
+    // 1) the demo machine (4 states, 5 transitions) with the suite's guards
+    for (size_t i = 0; i < sizeof(instance_counts) / sizeof(instance_counts[0]); i++) {
+        size_t n = instance_counts[i];
+        SuiteConfig c = { "table", STATE_COUNT, SUITE_TRANSITION_COUNT, n };
+        suite_run(&suite, &c, fresh_states(states, n), n, step_table, NULL);
+        c.machine = "compiled";
+        suite_run(&suite, &c, fresh_states(states, n), n, step_compiled, NULL);
+    }
+
+    // 2) synthetic tables: linear scan, per-state index and the batched engine
+    for (size_t t = 0; t < sizeof(table_sizes) / sizeof(table_sizes[0]); t++) {
+        size_t count;
+        size_t state_count = table_sizes[t][0];
+        Transition *table = bench_make_transitions(state_count, table_sizes[t][1], &count);
+        TransitionIndex index;
+        if (!table || !transition_index_build(&index, table, count, state_count)) {
+            free(table);
+            continue;
+        }
+        TableContext context = { table, count };
+
+        for (size_t i = 1; i < sizeof(instance_counts) / sizeof(instance_counts[0]); i++) {
+            size_t n = instance_counts[i];
+            SuiteConfig c = { "scan", state_count, count, n };
+            suite_run(&suite, &c, fresh_states(states, n), n, step_scan, &context);
+            c.machine = "index";
+            suite_run(&suite, &c, fresh_states(states, n), n, step_index, &index);
+            c.machine = "engine";
+            suite_run_engine(&suite, &c, table);
+        }
+
+        transition_index_free(&index);
+        free(table);
+    }
+
+    if (suite.csv) {
+        fclose(suite.csv);
+        printf("(CSV written to %s)\n", csv_name);
+    }
+    if (suite.cache_fd >= 0) close(suite.cache_fd);
+    if (suite.branch_fd >= 0) close(suite.branch_fd);
+    free(suite.samples);
+    free(states);
+}
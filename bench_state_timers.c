@@ -0,0 +1,93 @@
+/*
+ * bench_state_timers.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: timeouts with the timer wheel in StateEngine against checking
+ * a deadline per instance on every tick (what polling/spinning does).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "state_engine.h"
+
+#define BENCH_INSTANCES 1000000
+#define BENCH_TIMEOUT   1000        // ticks in MOVING before falling back to STILL
+
+void bench_state_timers(void)
+{
+    // no guarded transitions: only the timers move the instances
+    static const Transition table[] = {
+        { STATE_STILL, NULL, STATE_MOVING },
+    };
+    static const TimedTransition timed[] = {
+        { STATE_MOVING, BENCH_TIMEOUT, STATE_STILL },
+    };
+
+    // 1) deadline array, every tick looks at every instance
+    uint64_t *deadlines = malloc(BENCH_INSTANCES * sizeof(uint64_t));
+    State *states = malloc(BENCH_INSTANCES * sizeof(State));
+    if (!deadlines || !states) {
+        free(deadlines);
+        free(states);
+        return;
+    }
+    for (size_t i = 0; i < BENCH_INSTANCES; i++) {
+        states[i] = STATE_MOVING;
+        deadlines[i] = BENCH_TIMEOUT;
+    }
+
+    size_t fired = 0;
+    double start = bench_now();
+    for (uint64_t now = 1; now <= BENCH_TIMEOUT; now++) {
+        for (size_t i = 0; i < BENCH_INSTANCES; i++) {
+            if (deadlines[i] == now) {
+                states[i] = STATE_STILL;
+                fired++;
+            }
+        }
+    }
+    double scan_time = bench_now() - start;
+    printf("deadline scan: %10.1f us/tick (%zu pending, %zu expired)\n",
+           scan_time * 1e6 / BENCH_TIMEOUT, (size_t)BENCH_INSTANCES, fired);
+
+    // 2) timer wheel: ticks without expirations cost the same for 1 or 1M pending timers
+    StateEngine engine;
+    if (state_engine_init(&engine, table, 1, STATE_COUNT, BENCH_INSTANCES, STATE_MOVING) &&
+        state_engine_set_timeouts(&engine, timed, 1)) {
+        start = bench_now();
+        for (int t = 1; t < BENCH_TIMEOUT; t++)
+            fired = state_engine_tick(&engine);
+        double idle_time = bench_now() - start;
+
+        start = bench_now();
+        fired = state_engine_tick(&engine);
+        double expire_time = bench_now() - start;
+
+        printf("timer wheel:   %10.3f us/tick while waiting, %.1f ns per expired timer (%zu expired)\n",
+               idle_time * 1e6 / (BENCH_TIMEOUT - 1), expire_time * 1e9 / (fired ? fired : 1), fired);
+    }
+    state_engine_free(&engine);
+
+    free(deadlines);
+    free(states);
+}
@@ -0,0 +1,79 @@
+/*
+ * bench_state_trace.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: cost of observability in StateEngine - nothing attached (one
+ * untaken branch per transition), binary tracing on, and a transition action.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "state_engine.h"
+
+#define BENCH_STATES    16
+#define BENCH_PER_STATE 4
+#define BENCH_INSTANCES 1000000
+#define BENCH_STEPS     10
+
+static void count_transition(uint32_t instance, State from, State to, uint32_t transition, void *context)
+{
+    (void)instance; (void)from; (void)to; (void)transition;
+    (*(uint64_t *)context)++;
+}
+
+static void run(const char *label, StateEngine *e)
+{
+    double start = bench_now();
+    for (int s = 0; s < BENCH_STEPS; s++)
+        state_engine_step(e);
+    double seconds = bench_now() - start;
+    printf("%-24s %12.0f instance-steps/s\n", label, (double)BENCH_INSTANCES * BENCH_STEPS / seconds);
+}
+
+void bench_state_trace(void)
+{
+    size_t count;
+    Transition *table = bench_make_transitions(BENCH_STATES, BENCH_PER_STATE, &count);
+    StateEngine engine;
+    if (!table || !state_engine_init(&engine, table, count, BENCH_STATES, BENCH_INSTANCES, STATE_INIT)) {
+        free(table);
+        return;
+    }
+
+    // 1) tracing off, no actions
+    run("tracing off", &engine);
+
+    // 2) every transition goes to this thread's trace ring
+    state_trace_enable(1);
+    run("tracing on", &engine);
+    state_trace_free();
+
+    // 3) a transition action instead
+    uint64_t transitions = 0;
+    state_engine_set_actions(&engine, NULL, NULL, count_transition, &transitions);
+    run("transition action", &engine);
+    printf("(%llu transitions seen by the action)\n", (unsigned long long)transitions);
+
+    state_engine_free(&engine);
+    free(table);
+}
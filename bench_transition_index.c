@@ -0,0 +1,71 @@
+/*
+ * bench_transition_index.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: linear scan of a large synthetic transition table
+ * (transition_table_step) against the precompiled per-state index.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "transition_index.h"
+
+#define BENCH_STATES    500
+#define BENCH_PER_STATE 8
+#define BENCH_STEPS     200000
+
+void bench_transition_index(void)
+{
+    size_t count;
+    Transition *table = bench_make_transitions(BENCH_STATES, BENCH_PER_STATE, &count);
+    if (!table) return;
+
+    // 1) linear scan of the whole table on every step
+    State state = STATE_INIT;
+    double start = bench_now();
+    for (size_t i = 0; i < BENCH_STEPS; i++)
+        state = transition_table_step(table, count, state);
+    double scan_time = bench_now() - start;
+    printf("linear scan (%zu transitions): %12.0f steps/s (state=%d)\n",
+           count, BENCH_STEPS / scan_time, (int)state);
+
+    // 2) per-state index, built once
+    TransitionIndex index;
+    start = bench_now();
+    if (!transition_index_build(&index, table, count, BENCH_STATES)) {
+        free(table);
+        return;
+    }
+    double build_time = bench_now() - start;
+
+    state = STATE_INIT;
+    start = bench_now();
+    for (size_t i = 0; i < BENCH_STEPS; i++)
+        state = transition_index_step(&index, state);
+    double index_time = bench_now() - start;
+    printf("per-state index:                %12.0f steps/s (state=%d, built in %.3f ms)\n",
+           BENCH_STEPS / index_time, (int)state, build_time * 1000);
+
+    transition_index_free(&index);
+    free(table);
+}
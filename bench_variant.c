@@ -0,0 +1,116 @@
+/*
+ * bench_variant.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: a mixed telemetry stream of variants serialized as fixed
+ * records (tag + the whole union) against the compact encoding (tag + the
+ * payload of the active type).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "variant.h"
+
+#define BENCH_VALUES 5000000
+#define BENCH_FIXED_SIZE (1 + sizeof(((Variant *)0)->as))
+
+// telemetry mix: mostly int32 and float, some wide numbers, a few strings
+static Variant bench_value(unsigned random)
+{
+    Variant v;
+    unsigned kind = random % 100;
+    if (kind < 40) return variant_int32((int32_t)(random % 1000));
+    if (kind < 70) return variant_float((float)(random % 1000) * 0.1f);
+    if (kind < 85) return variant_double((double)random * 1e-3);
+    if (kind < 95) return variant_int64((int64_t)random << 24);
+    static const char *names[] = { "ok", "warn", "error", "overheated", "disconnected" };
+    const char *name = names[random % 5];
+    variant_string(&v, name, strlen(name));
+    return v;
+}
+
+void bench_variant(void)
+{
+    Variant *values = malloc(BENCH_VALUES * sizeof(Variant));
+    Variant *decoded = malloc(BENCH_VALUES * sizeof(Variant));
+    uint8_t *buffer = malloc(BENCH_VALUES * BENCH_FIXED_SIZE);
+    if (!values || !decoded || !buffer) {
+        free(values);
+        free(decoded);
+        free(buffer);
+        return;
+    }
+
+    unsigned seed = 31337;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = bench_value(seed >> 8);
+    }
+    memset(decoded, 0, BENCH_VALUES * sizeof(Variant));     // no page faults in the timings
+    memset(buffer, 0, BENCH_VALUES * BENCH_FIXED_SIZE);
+
+    // 1) fixed records: the tag and the widest member, whatever is active
+    double start = bench_now();
+    uint8_t *p = buffer;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        p[0] = (uint8_t)(values[i].type | values[i].length << 4);
+        memcpy(p + 1, &values[i].as, sizeof(values[i].as));
+        p += BENCH_FIXED_SIZE;
+    }
+    double fixed_encode = bench_now() - start;
+    size_t fixed_bytes = (size_t)(p - buffer);
+
+    start = bench_now();
+    p = buffer;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        memcpy(&decoded[i].as, p + 1, sizeof(decoded[i].as));
+        decoded[i].type = p[0] & 0x0F;
+        decoded[i].length = p[0] >> 4;
+        p += BENCH_FIXED_SIZE;
+    }
+    double fixed_decode = bench_now() - start;
+
+    // 2) compact: the tag and the payload of the active type
+    start = bench_now();
+    size_t compact_bytes = 0;
+    variant_encode_array(values, BENCH_VALUES, buffer, &compact_bytes);
+    double compact_encode = bench_now() - start;
+
+    start = bench_now();
+    size_t count = variant_decode_array(buffer, compact_bytes, decoded, BENCH_VALUES, NULL);
+    double compact_decode = bench_now() - start;
+
+    size_t differ = 0;
+    for (size_t i = 0; i < count; i++) differ += !variant_equal(&values[i], &decoded[i]);
+
+    printf("%d values, fixed:   %9zu bytes (%.2f per value), encode %7.2f ms, decode %7.2f ms\n",
+           BENCH_VALUES, fixed_bytes, (double)fixed_bytes / BENCH_VALUES, fixed_encode * 1e3, fixed_decode * 1e3);
+    printf("%d values, compact: %9zu bytes (%.2f per value), encode %7.2f ms, decode %7.2f ms (%zu decoded, %zu differ)\n",
+           BENCH_VALUES, compact_bytes, (double)compact_bytes / BENCH_VALUES, compact_encode * 1e3,
+           compact_decode * 1e3, count, differ);
+
+    free(values);
+    free(decoded);
+    free(buffer);
+}
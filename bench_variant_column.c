@@ -0,0 +1,117 @@
+/*
+ * bench_variant_column.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: aggregation over mixed-type variants - a switch on the tag of
+ * every row against the per-type dense arrays of VariantColumns.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "variant_column.h"
+
+#define BENCH_VALUES 10000000
+#define BENCH_ROUNDS 5
+
+void bench_variant_column(void)
+{
+    Variant *rows = malloc(BENCH_VALUES * sizeof(Variant));
+    Variant *back = malloc(BENCH_VALUES * sizeof(Variant));
+    VariantColumns columns;
+    if (!rows || !back) {
+        free(rows);
+        free(back);
+        return;
+    }
+
+    // random mix, so the type of the next row cannot be predicted
+    unsigned seed = 4242;
+    for (size_t i = 0; i < BENCH_VALUES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        unsigned random = seed >> 8;
+        switch (random % 5) {
+            case 0: rows[i] = variant_int32((int32_t)(random % 1000)); break;
+            case 1: rows[i] = variant_int64((int64_t)(random % 1000) << 20); break;
+            case 2: rows[i] = variant_float((float)(random % 1000) * 0.5f); break;
+            case 3: rows[i] = variant_double((double)(random % 1000) * 0.25); break;
+            default: variant_string(&rows[i], "sensor", 6); break;
+        }
+    }
+    memset(back, 0, BENCH_VALUES * sizeof(Variant));     // no page faults in the timings
+
+    double start = bench_now();
+    if (!variant_columns_from_rows(&columns, rows, BENCH_VALUES)) {
+        free(rows);
+        free(back);
+        return;
+    }
+    double split_time = bench_now() - start;
+
+    start = bench_now();
+    variant_columns_to_rows(&columns, back);
+    double join_time = bench_now() - start;
+    size_t differ = 0;
+    for (size_t i = 0; i < BENCH_VALUES; i++) differ += !variant_equal(&rows[i], &back[i]);
+    printf("%d values: to columns %.2f ms, back to rows %.2f ms (%zu differ)\n",
+           BENCH_VALUES, split_time * 1e3, join_time * 1e3, differ);
+
+    // 1) rows: a switch on the tag of every value
+    int64_t ints = 0;
+    double reals = 0;
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        ints = 0;
+        reals = 0;
+        for (size_t i = 0; i < BENCH_VALUES; i++) {
+            switch (rows[i].type) {
+                case VARIANT_INT32:  ints += rows[i].as.i32; break;
+                case VARIANT_INT64:  ints += rows[i].as.i64; break;
+                case VARIANT_FLOAT:  reals += rows[i].as.f32; break;
+                case VARIANT_DOUBLE: reals += rows[i].as.f64; break;
+            }
+        }
+    }
+    double rows_time = (bench_now() - start) / BENCH_ROUNDS;
+
+    // 2) columns: straight loops over the dense arrays
+    int64_t column_ints = 0;
+    double column_reals = 0;
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        column_ints = variant_columns_sum_ints(&columns);
+        column_reals = variant_columns_sum_reals(&columns);
+    }
+    double columns_time = (bench_now() - start) / BENCH_ROUNDS;
+
+    printf("sum by type, rows:    %8.2f ms (ints %lld, reals %.1f, %zu bytes)\n", rows_time * 1e3,
+           (long long)ints, reals, (size_t)BENCH_VALUES * sizeof(Variant));
+    printf("sum by type, columns: %8.2f ms (ints %lld, reals %.1f, %zu bytes of numbers)\n", columns_time * 1e3,
+           (long long)column_ints, column_reals,
+           columns.counts[VARIANT_INT32] * sizeof(int32_t) + columns.counts[VARIANT_INT64] * sizeof(int64_t) +
+           columns.counts[VARIANT_FLOAT] * sizeof(float) + columns.counts[VARIANT_DOUBLE] * sizeof(double));
+
+    variant_columns_free(&columns);
+    free(rows);
+    free(back);
+}
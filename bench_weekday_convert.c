@@ -0,0 +1,141 @@
+/*
+ * bench_weekday_convert.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: timestamps to weekday masks and names - localtime() with the
+ * switch/if chains of bitunions_main against the lookup tables of weekday.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "weekday.h"
+
+#define BENCH_TIMES  2000000
+#define BENCH_ROUNDS 5
+
+// the code of bitunions_main: a switch to set the bit
+static WeekdayBits switch_from_wday(int wday)
+{
+    WeekdayBits day = {0};
+    switch (wday) {
+        case 0: day.bits.sun = 1; break;
+        case 1: day.bits.mon = 1; break;
+        case 2: day.bits.tue = 1; break;
+        case 3: day.bits.wed = 1; break;
+        case 4: day.bits.thu = 1; break;
+        case 5: day.bits.fri = 1; break;
+        case 6: day.bits.sat = 1; break;
+    }
+    return day;
+}
+
+// ... and seven ifs to find the name
+static const char *if_name(WeekdayBits day)
+{
+    const char *name = "";
+    if (day.bits.mon) name = "Monday";
+    if (day.bits.tue) name = "Tuesday";
+    if (day.bits.wed) name = "Wednesday";
+    if (day.bits.thu) name = "Thursday";
+    if (day.bits.fri) name = "Friday";
+    if (day.bits.sat) name = "Saturday";
+    if (day.bits.sun) name = "Sunday";
+    return name;
+}
+
+void bench_weekday_convert(void)
+{
+    time_t *times = malloc(BENCH_TIMES * sizeof(time_t));
+    uint8_t *masks = malloc(BENCH_TIMES);
+    uint8_t *expected = malloc(BENCH_TIMES);
+    if (!times || !masks || !expected) {
+        free(times);
+        free(masks);
+        free(expected);
+        return;
+    }
+
+    // random timestamps between 2000 and 2040, so the weekday is unpredictable
+    unsigned seed = 2024;
+    for (size_t i = 0; i < BENCH_TIMES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        unsigned high = seed >> 16;
+        seed = seed * 1103515245u + 12345u;
+        times[i] = 946684800 + (time_t)(((uint64_t)high << 16 | seed >> 16) % (40ull * 365 * 86400));
+    }
+
+    // 1) localtime_r and the switch, one timestamp at a time
+    double start = bench_now();
+    for (size_t i = 0; i < BENCH_TIMES; i++) {
+        struct tm tm;
+        localtime_r(&times[i], &tm);
+        expected[i] = switch_from_wday(tm.tm_wday).value;
+    }
+    double local_time = bench_now() - start;
+
+    // 2) integer arithmetic with the offset of the local time zone now
+    struct tm now_tm;
+    time_t now = time(NULL);
+    localtime_r(&now, &now_tm);
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+        weekday_masks_from_times(times, masks, BENCH_TIMES, (int32_t)now_tm.tm_gmtoff);
+    double bulk_time = (bench_now() - start) / BENCH_ROUNDS;
+
+    size_t differ = 0;
+    for (size_t i = 0; i < BENCH_TIMES; i++) differ += masks[i] != expected[i];
+    printf("%d timestamps, localtime + switch: %8.2f ms\n", BENCH_TIMES, local_time * 1e3);
+    printf("%d timestamps, bulk arithmetic:    %8.2f ms (%zu differ: daylight saving)\n",
+           BENCH_TIMES, bulk_time * 1e3, differ);
+
+    // 3) tm_wday -> mask -> name, the switch/if chains against the tables
+    int *wdays = malloc(BENCH_TIMES * sizeof(int));
+    if (wdays) {
+        for (size_t i = 0; i < BENCH_TIMES; i++) wdays[i] = weekday_to_tm_wday((WeekdayBits){ .value = masks[i] });
+
+        size_t length = 0;
+        start = bench_now();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            for (size_t i = 0; i < BENCH_TIMES; i++)
+                length += strlen(if_name(switch_from_wday(wdays[i])));
+        double chain_time = (bench_now() - start) / BENCH_ROUNDS;
+        size_t chain_length = length / BENCH_ROUNDS;
+
+        length = 0;
+        start = bench_now();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+            for (size_t i = 0; i < BENCH_TIMES; i++)
+                length += strlen(weekday_name(weekday_from_tm_wday(wdays[i])));
+        double table_time = (bench_now() - start) / BENCH_ROUNDS;
+
+        printf("name lookup, switch + ifs: %8.2f ms (%zu chars)\n", chain_time * 1e3, chain_length);
+        printf("name lookup, tables + ctz: %8.2f ms (%zu chars)\n", table_time * 1e3, length / BENCH_ROUNDS);
+        free(wdays);
+    }
+
+    free(times);
+    free(masks);
+    free(expected);
+}
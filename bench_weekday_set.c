@@ -0,0 +1,105 @@
+/*
+ * bench_weekday_set.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: population queries over weekday schedules - one WeekdayBits
+ * per user checked with bit-fields against the bit-plane WeekdaySet.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "weekday_set.h"
+
+#define BENCH_USERS  10000000
+#define BENCH_ROUNDS 5
+
+void bench_weekday_set(void)
+{
+    WeekdayBits *rows = malloc(BENCH_USERS * sizeof(WeekdayBits));
+    WeekdaySet set;
+    if (!rows || !weekday_set_init(&set, BENCH_USERS)) {
+        free(rows);
+        return;
+    }
+
+    // random schedules, every day active with probability 1/2
+    unsigned seed = 12345;
+    for (size_t i = 0; i < BENCH_USERS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        rows[i].value = (unsigned char)((seed >> 16) & WEEKDAY_ALL);
+    }
+
+    double start = bench_now();
+    weekday_set_pack(&set, rows, BENCH_USERS);
+    printf("pack %d users: %.1f ms (%zu -> %zu bytes)\n", BENCH_USERS, (bench_now() - start) * 1e3,
+           (size_t)BENCH_USERS * sizeof(WeekdayBits), set.words * WEEKDAY_COUNT * sizeof(uint64_t));
+
+    // 1) "active on Monday and Friday", one record at a time with the bit-fields
+    size_t count = 0;
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        count = 0;
+        for (size_t i = 0; i < BENCH_USERS; i++)
+            if (rows[i].bits.mon && rows[i].bits.fri) count++;
+    }
+    double fields_time = (bench_now() - start) / BENCH_ROUNDS;
+
+    // 2) the same question on the bit planes
+    size_t matched = 0;
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+        matched = weekday_set_match_all(&set, WEEKDAY_MON | WEEKDAY_FRI, NULL);
+    double planes_time = (bench_now() - start) / BENCH_ROUNDS;
+
+    printf("mon & fri, bit-fields: %8.2f ms (%zu users)\n", fields_time * 1e3, count);
+    printf("mon & fri, bit planes: %8.2f ms (%zu users)\n", planes_time * 1e3, matched);
+
+    // 3) active users per weekday
+    size_t counts[WEEKDAY_COUNT] = {0};
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int d = 0; d < WEEKDAY_COUNT; d++) counts[d] = 0;
+        for (size_t i = 0; i < BENCH_USERS; i++) {
+            if (rows[i].bits.mon) counts[0]++;
+            if (rows[i].bits.tue) counts[1]++;
+            if (rows[i].bits.wed) counts[2]++;
+            if (rows[i].bits.thu) counts[3]++;
+            if (rows[i].bits.fri) counts[4]++;
+            if (rows[i].bits.sat) counts[5]++;
+            if (rows[i].bits.sun) counts[6]++;
+        }
+    }
+    fields_time = (bench_now() - start) / BENCH_ROUNDS;
+    size_t monday = counts[0];
+
+    start = bench_now();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+        weekday_set_day_counts(&set, counts);
+    planes_time = (bench_now() - start) / BENCH_ROUNDS;
+
+    printf("per weekday, bit-fields: %6.2f ms (monday %zu)\n", fields_time * 1e3, monday);
+    printf("per weekday, bit planes: %6.2f ms (monday %zu)\n", planes_time * 1e3, counts[0]);
+
+    weekday_set_free(&set);
+    free(rows);
+}
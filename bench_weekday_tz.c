@@ -0,0 +1,131 @@
+/*
+ * bench_weekday_tz.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Benchmark: timestamps to local weekday masks - localtime_r() per
+ * timestamp against the cached time zone of weekday_tz.h, on one and on
+ * several threads. Set TZ (e.g. TZ=Europe/Stockholm) to include daylight
+ * saving transitions.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bench.h"
+#include "weekday.h"
+#include "weekday_tz.h"
+
+#define BENCH_TIMES   4000000
+#define BENCH_THREADS 4
+#define BENCH_FROM    946684800     // 2000-01-01
+#define BENCH_YEARS   40
+
+typedef struct {
+    const WeekdayTz *tz;    // NULL: localtime_r()
+    const time_t *times;
+    uint8_t *masks;
+    size_t count;
+} TzJob;
+
+static void *tz_job(void *argument)
+{
+    TzJob *job = argument;
+    if (job->tz) {
+        weekday_tz_masks(job->tz, job->times, job->masks, job->count);
+        return NULL;
+    }
+    for (size_t i = 0; i < job->count; i++) {
+        struct tm tm;
+        localtime_r(&job->times[i], &tm);
+        job->masks[i] = weekday_from_tm_wday(tm.tm_wday).value;
+    }
+    return NULL;
+}
+
+// all timestamps split over the threads; returns the seconds taken
+static double tz_run(const WeekdayTz *tz, const time_t *times, uint8_t *masks, int threads)
+{
+    pthread_t ids[BENCH_THREADS];
+    TzJob jobs[BENCH_THREADS];
+    size_t share = BENCH_TIMES / threads;
+
+    double start = bench_now();
+    for (int t = 0; t < threads; t++) {
+        jobs[t] = (TzJob){ tz, times + t * share, masks + t * share,
+                           t == threads - 1 ? BENCH_TIMES - t * share : share };
+        if (t > 0) pthread_create(&ids[t], NULL, tz_job, &jobs[t]);
+    }
+    tz_job(&jobs[0]);
+    for (int t = 1; t < threads; t++) pthread_join(ids[t], NULL);
+    return bench_now() - start;
+}
+
+void bench_weekday_tz(void)
+{
+    time_t *times = malloc(BENCH_TIMES * sizeof(time_t));
+    uint8_t *masks = malloc(BENCH_TIMES);
+    uint8_t *expected = malloc(BENCH_TIMES);
+    WeekdayTz tz;
+    if (!times || !masks || !expected) {
+        free(times);
+        free(masks);
+        free(expected);
+        return;
+    }
+
+    unsigned seed = 777;
+    for (size_t i = 0; i < BENCH_TIMES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        unsigned high = seed >> 16;
+        seed = seed * 1103515245u + 12345u;
+        times[i] = BENCH_FROM + (time_t)(((uint64_t)high << 16 | seed >> 16) % (BENCH_YEARS * 31556952ull));
+    }
+
+    double start = bench_now();
+    int cached = weekday_tz_init(&tz, BENCH_FROM, BENCH_FROM + BENCH_YEARS * 31556952LL);
+    double init_time = bench_now() - start;
+    if (!cached) {
+        free(times);
+        free(masks);
+        free(expected);
+        return;
+    }
+    printf("cache %d years: %.2f ms, %zu periods\n", BENCH_YEARS, init_time * 1e3, tz.count);
+
+    for (int threads = 1; threads <= BENCH_THREADS; threads *= BENCH_THREADS) {
+        double local_time = tz_run(NULL, times, expected, threads);
+        double cached_time = tz_run(&tz, times, masks, threads);
+
+        size_t differ = 0;
+        for (size_t i = 0; i < BENCH_TIMES; i++) differ += masks[i] != expected[i];
+        printf("%d thread(s), localtime_r: %8.2f ms (%6.1f M/s)\n", threads, local_time * 1e3,
+               BENCH_TIMES / local_time / 1e6);
+        printf("%d thread(s), cached zone: %8.2f ms (%6.1f M/s, %zu differ)\n", threads, cached_time * 1e3,
+               BENCH_TIMES / cached_time / 1e6, differ);
+    }
+
+    weekday_tz_free(&tz);
+    free(times);
+    free(masks);
+    free(expected);
+}
@@ -0,0 +1,197 @@
+/*
+ * event_queue.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Bounded lock-free MPSC queue (ring buffer with a sequence number per slot)
+ * with eventfd wake-up of the consumer.
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "event_queue.h"
+
+// CLOCK_MONOTONIC time in nanoseconds
+uint64_t event_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*
+ * event_queue_init - create an empty queue
+ * @q: queue to initialize
+ * @capacity: number of slots, rounded up to a power of two
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int event_queue_init(EventQueue *q, size_t capacity)
+{
+    if (!q) return 0;
+
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+
+    q->slots = malloc(size * sizeof(EventSlot));
+    if (!q->slots) return 0;
+
+    q->efd = eventfd(0, EFD_CLOEXEC);
+    if (q->efd < 0) {
+        free(q->slots);
+        q->slots = NULL;
+        return 0;
+    }
+
+    // slot i is free for the producer that gets position i
+    for (size_t i = 0; i < size; i++)
+        atomic_init(&q->slots[i].sequence, i);
+
+    q->mask = size - 1;
+    atomic_init(&q->tail, 0);
+    q->head = 0;
+    atomic_init(&q->waiting, 0);
+    return 1;
+}
+
+// Release the queue (no producer may use it any more)
+void event_queue_free(EventQueue *q)
+{
+    if (!q || !q->slots) return;
+
+    close(q->efd);
+    free(q->slots);
+    q->slots = NULL;
+}
+
+/*
+ * event_queue_push - add an event, safe to call from any number of threads
+ * Returns: 1 on success, 0 if the queue is full
+ */
+int event_queue_push(EventQueue *q, EventType type, uint32_t instance)
+{
+    size_t position = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    EventSlot *slot;
+
+    // claim a slot: it is ours when its sequence equals our position
+    while (1) {
+        slot = &q->slots[position & q->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return 0;   // the consumer has not freed this slot yet - full
+        } else {
+            position = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+
+    slot->event.type = type;
+    slot->event.instance = instance;
+    slot->event.timestamp_ns = event_now_ns();
+
+    // publish the event to the consumer
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+
+    // wake the consumer only if it is asleep (one syscall per sleep, not per event)
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&q->waiting, memory_order_relaxed) &&
+        atomic_exchange(&q->waiting, 0)) {
+        uint64_t one = 1;
+        while (write(q->efd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+    }
+    return 1;
+}
+
+/*
+ * event_queue_try_pop - take the oldest event without blocking (consumer only)
+ * Returns: 1 if an event was taken, 0 if the queue is empty
+ */
+int event_queue_try_pop(EventQueue *q, Event *out)
+{
+    EventSlot *slot = &q->slots[q->head & q->mask];
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    if (sequence != q->head + 1) return 0;
+
+    *out = slot->event;
+
+    // the slot becomes free for the producer one lap later
+    atomic_store_explicit(&slot->sequence, q->head + q->mask + 1, memory_order_release);
+    q->head++;
+    return 1;
+}
+
+/*
+ * event_queue_wait - take the oldest event, sleep while the queue is empty
+ * @q: queue
+ * @out: the event
+ * @timeout_ms: maximum time to sleep, -1 = no limit
+ *
+ * Returns: 1 if an event was taken, 0 on timeout
+ */
+int event_queue_wait(EventQueue *q, Event *out, int timeout_ms)
+{
+    // a wake-up without an event (or EINTR) sleeps again only for the time that is left
+    uint64_t deadline = timeout_ms >= 0 ? event_now_ns() + (uint64_t)timeout_ms * 1000000ull : 0;
+
+    while (1) {
+        if (event_queue_try_pop(q, out)) return 1;
+
+        // announce that we go to sleep, then look again - the fence pairs with
+        // the one in event_queue_push: a producer either sees the flag or we see its event
+        atomic_store(&q->waiting, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (event_queue_try_pop(q, out)) {
+            atomic_store(&q->waiting, 0);
+            return 1;
+        }
+
+        int wait_ms = -1;
+        if (timeout_ms >= 0) {
+            uint64_t now = event_now_ns();
+            // round up, so that we do not wake up just before the deadline and spin
+            wait_ms = now < deadline ? (int)((deadline - now + 999999) / 1000000) : 0;
+        }
+
+        struct pollfd pfd = { q->efd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, wait_ms);
+        if (ready == 0) {
+            atomic_store(&q->waiting, 0);
+            return event_queue_try_pop(q, out);
+        }
+
+        // clear the eventfd counter (a wake-up without an event is harmless)
+        if (ready > 0) {
+            uint64_t value;
+            if (read(q->efd, &value, sizeof(value)) < 0 && errno != EAGAIN && errno != EINTR)
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * event_queue.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Lock-free multi-producer single-consumer event queue.
+ * Producers (any thread) push events into a bounded ring buffer without locks;
+ * the single consumer (the state machine) pops them. When the queue is empty
+ * the consumer sleeps on an eventfd, so an idle state machine uses no CPU.
+ * A producer only makes the eventfd syscall when the consumer is asleep.
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* Events that drive the state machine */
+typedef enum {
+    EVENT_NONE,         // no event - only unconditional transitions are taken
+    EVENT_START,        // start moving
+    EVENT_STOP,         // stop moving
+    EVENT_SHUTDOWN,     // stop the machine
+    EVENT_TIMEOUT,      // a timer expired
+    EVENT_COUNT
+} EventType;
+
+typedef struct {
+    EventType type;
+    uint32_t  instance;         // which machine the event is for
+    uint64_t  timestamp_ns;     // CLOCK_MONOTONIC time of the push, for latency measurement
+} Event;
+
+typedef struct {
+    atomic_size_t sequence;     // tells producers and the consumer whose turn the slot is
+    Event         event;
+} EventSlot;
+
+typedef struct {
+    EventSlot *slots;
+    size_t     mask;                        // capacity - 1 (capacity is a power of two)
+    _Alignas(64) atomic_size_t tail;        // next slot for producers
+    _Alignas(64) size_t head;               // next slot for the consumer
+    _Alignas(64) atomic_int waiting;        // consumer sleeps on the eventfd
+    int        efd;                         // eventfd used to wake the consumer
+} EventQueue;
+
+int event_queue_init(EventQueue *q, size_t capacity);
+void event_queue_free(EventQueue *q);
+int event_queue_push(EventQueue *q, EventType type, uint32_t instance);
+int event_queue_try_pop(EventQueue *q, Event *out);
+int event_queue_wait(EventQueue *q, Event *out, int timeout_ms);
+uint64_t event_now_ns(void);
+
+#endif
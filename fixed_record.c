@@ -0,0 +1,265 @@
+/*
+ * fixed_record.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Fixed-record files with a validated layout header.
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "fixed_record.h"
+#include "structure_definition.h"
+
+_Static_assert(sizeof(FixedRecordHeader) <= FIXED_RECORD_HEADER_SIZE,
+               "FixedRecordHeader does not fit in the reserved header space");
+
+const FixedRecordLayout fixed_layout_person = {
+    FIXED_RECORD_TYPE_PERSON, sizeof(struct_person), 3,
+    { FIXED_FIELD(struct_person, iAge),
+      FIXED_FIELD(struct_person, name),
+      FIXED_FIELD(struct_person, address) }
+};
+
+const FixedRecordLayout fixed_layout_person_small = {
+    FIXED_RECORD_TYPE_PERSON_SMALL, sizeof(struct_person_small), 2,
+    { FIXED_FIELD(struct_person_small, iAge),
+      FIXED_FIELD(struct_person_small, name) }
+};
+
+// byte order of this machine
+static uint8_t host_endianness(void)
+{
+    const uint16_t one = 1;
+    return *(const uint8_t *)&one ? FIXED_RECORD_LITTLE_ENDIAN : FIXED_RECORD_BIG_ENDIAN;
+}
+
+/*
+ * check_header - compare the header of a file with the layout of the program
+ * Returns: 1 if they match, 0 otherwise (the reason is printed on stderr)
+ */
+static int check_header(const FixedRecordHeader *h, const FixedRecordLayout *layout)
+{
+    // a single byte reads the same in both byte orders, so it is checked first:
+    // in a byte-swapped file the magic and the version do not match either
+    if (h->endianness != host_endianness() &&
+        (h->endianness == FIXED_RECORD_LITTLE_ENDIAN || h->endianness == FIXED_RECORD_BIG_ENDIAN) &&
+        h->magic == __builtin_bswap32(FIXED_RECORD_MAGIC)) {
+        fprintf(stderr, "fixed_record: file was written on a machine with another byte order\n");
+        return 0;
+    }
+    if (h->magic != FIXED_RECORD_MAGIC || h->version != FIXED_RECORD_VERSION ||
+        h->endianness != host_endianness()) {
+        fprintf(stderr, "fixed_record: not a fixed-record file (or unknown version)\n");
+        return 0;
+    }
+    if (h->layout.type_id != layout->type_id) {
+        fprintf(stderr, "fixed_record: file holds record type %u, expected %u\n",
+                h->layout.type_id, layout->type_id);
+        return 0;
+    }
+    if (h->layout.record_size != layout->record_size) {
+        fprintf(stderr, "fixed_record: record size is %u in the file, %u in the program "
+                "(padding or packing changed?)\n", h->layout.record_size, layout->record_size);
+        return 0;
+    }
+    if (h->layout.field_count != layout->field_count) {
+        fprintf(stderr, "fixed_record: %u fields in the file, %u in the program\n",
+                h->layout.field_count, layout->field_count);
+        return 0;
+    }
+    for (uint32_t i = 0; i < layout->field_count; i++) {
+        if (h->layout.fields[i].offset != layout->fields[i].offset ||
+            h->layout.fields[i].size != layout->fields[i].size) {
+            fprintf(stderr, "fixed_record: field %u is at offset %u (size %u) in the file, "
+                    "at offset %u (size %u) in the program\n", i,
+                    h->layout.fields[i].offset, h->layout.fields[i].size,
+                    layout->fields[i].offset, layout->fields[i].size);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * fixed_record_write_header - describe the layout at the start of the file
+ * @f: file opened in binary write mode, at the beginning
+ * @layout: layout of the records that follow
+ * @count: number of records that follow
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int fixed_record_write_header(FILE *f, const FixedRecordLayout *layout, uint64_t count)
+{
+    if (!f || !layout || layout->field_count > FIXED_RECORD_MAX_FIELDS) return 0;
+
+    unsigned char space[FIXED_RECORD_HEADER_SIZE] = {0};
+    FixedRecordHeader header;
+    memset(&header, 0, sizeof(header));   // no random padding bytes in the file
+
+    header.magic = FIXED_RECORD_MAGIC;
+    header.version = FIXED_RECORD_VERSION;
+    header.endianness = host_endianness();
+    header.record_count = count;
+    header.layout = *layout;
+
+    memcpy(space, &header, sizeof(header));
+    return fwrite(space, sizeof(space), 1, f) == 1;
+}
+
+/*
+ * fixed_record_read_header - read and check the header
+ * @f: file opened in binary read mode, at the beginning
+ * @layout: layout the program expects
+ * @count: number of records in the file (output)
+ *
+ * Returns: 1 if the file matches the layout, 0 otherwise
+ * On success the file is positioned at the first record.
+ */
+int fixed_record_read_header(FILE *f, const FixedRecordLayout *layout, uint64_t *count)
+{
+    if (!f || !layout || !count) return 0;
+
+    unsigned char space[FIXED_RECORD_HEADER_SIZE];
+    if (fread(space, sizeof(space), 1, f) != 1) return 0;
+
+    FixedRecordHeader header;
+    memcpy(&header, space, sizeof(header));
+    if (!check_header(&header, layout)) return 0;
+
+    *count = header.record_count;
+    return 1;
+}
+
+/*
+ * fixed_record_save - write a whole array of records with one fwrite
+ * Returns: 1 on success, 0 on failure
+ */
+int fixed_record_save(const char *filename, const FixedRecordLayout *layout,
+                      const void *records, size_t count)
+{
+    if (!records && count > 0) return 0;
+
+    FILE *f = fopen(filename, "wb");
+    if (!f) {
+        perror("fopen");
+        return 0;
+    }
+
+    int ok = fixed_record_write_header(f, layout, count) &&
+             fwrite(records, layout->record_size, count, f) == count;
+
+    if (fclose(f) != 0) ok = 0;
+    return ok;
+}
+
+/*
+ * fixed_record_load - read the records straight into a preallocated array
+ * @filename: path to the file
+ * @layout: layout the program expects
+ * @records: array with room for capacity records
+ * @capacity: size of the array in records
+ *
+ * Returns: number of records read (0 if the layout does not match)
+ */
+size_t fixed_record_load(const char *filename, const FixedRecordLayout *layout,
+                         void *records, size_t capacity)
+{
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        perror("fopen");
+        return 0;
+    }
+
+    uint64_t count;
+    size_t read = 0;
+    if (fixed_record_read_header(f, layout, &count)) {
+        if (count > capacity) count = capacity;
+        // one fread for all the records
+        read = fread(records, layout->record_size, count, f);
+    }
+
+    fclose(f);
+    return read;
+}
+
+/*
+ * fixed_record_map_open - map the file and use it directly as an array
+ * Returns: 1 on success, 0 on failure or if the layout does not match
+ */
+int fixed_record_map_open(FixedRecordMap *map, const char *filename, const FixedRecordLayout *layout)
+{
+    if (!map || !layout) return 0;
+    memset(map, 0, sizeof(*map));
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < FIXED_RECORD_HEADER_SIZE) {
+        fprintf(stderr, "fixed_record: %s is too small\n", filename);
+        close(fd);
+        return 0;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        return 0;
+    }
+
+    FixedRecordHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    // the file must also be long enough for all the records it announces
+    uint64_t available = (st.st_size - FIXED_RECORD_HEADER_SIZE) / layout->record_size;
+    if (!check_header(&header, layout)) {
+        munmap(data, st.st_size);
+        return 0;
+    }
+    if (header.record_count > available) {
+        fprintf(stderr, "fixed_record: %s is truncated\n", filename);
+        munmap(data, st.st_size);
+        return 0;
+    }
+
+    map->mapping = data;
+    map->size = st.st_size;
+    map->records = (const unsigned char *)data + FIXED_RECORD_HEADER_SIZE;
+    map->count = header.record_count;
+    return 1;
+}
+
+// Unmap the file, the record array becomes invalid
+void fixed_record_map_close(FixedRecordMap *map)
+{
+    if (map && map->mapping) {
+        munmap(map->mapping, map->size);
+        memset(map, 0, sizeof(*map));
+    }
+}
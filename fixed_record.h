@@ -0,0 +1,99 @@
+/*
+ * fixed_record.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Files of fixed-size POD records (struct_person, struct_person_small, ...).
+ * The file starts with a header that describes the record layout: sizeof, the
+ * offset and size of every field, and the byte order. Reading checks this
+ * description against the layout of the program, so a change in padding
+ * (e.g. #pragma pack) or byte order is reported instead of silently
+ * corrupting the data. After the header the records follow as a raw array,
+ * which can be read with one fread or mapped with mmap.
+ */
+
+#ifndef FIXED_RECORD_H
+#define FIXED_RECORD_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FIXED_RECORD_MAGIC      0x43455246u     // "FREC" in a little-endian file
+#define FIXED_RECORD_VERSION    1
+#define FIXED_RECORD_MAX_FIELDS 8
+
+#define FIXED_RECORD_LITTLE_ENDIAN 1
+#define FIXED_RECORD_BIG_ENDIAN    2
+
+// record type identifiers, stored in the file
+#define FIXED_RECORD_TYPE_PERSON       1    // struct_person
+#define FIXED_RECORD_TYPE_PERSON_SMALL 2    // struct_person_small
+#define FIXED_RECORD_TYPE_SPERSON      3    // struct sPerson (read_binary_file.c)
+
+typedef struct {
+    uint32_t offset;    // offsetof(type, member)
+    uint32_t size;      // sizeof(member)
+} FixedField;
+
+// describe one member of a structure
+#define FIXED_FIELD(type, member) { offsetof(type, member), sizeof(((type *)0)->member) }
+
+typedef struct {
+    uint32_t   type_id;
+    uint32_t   record_size;
+    uint32_t   field_count;
+    FixedField fields[FIXED_RECORD_MAX_FIELDS];
+} FixedRecordLayout;
+
+// the header is padded to FIXED_RECORD_HEADER_SIZE bytes, so the records in a mapped file are aligned
+typedef struct {
+    uint32_t          magic;
+    uint16_t          version;
+    uint8_t           endianness;
+    uint8_t           reserved;
+    uint64_t          record_count;
+    FixedRecordLayout layout;
+} FixedRecordHeader;
+
+#define FIXED_RECORD_HEADER_SIZE 128
+
+// a file mapped as an array of records
+typedef struct {
+    const void *records;    // the record array
+    size_t      count;      // number of records
+    void       *mapping;    // start of the mapping (the header)
+    size_t      size;       // size of the mapping
+} FixedRecordMap;
+
+extern const FixedRecordLayout fixed_layout_person;
+extern const FixedRecordLayout fixed_layout_person_small;
+
+int fixed_record_write_header(FILE *f, const FixedRecordLayout *layout, uint64_t count);
+int fixed_record_read_header(FILE *f, const FixedRecordLayout *layout, uint64_t *count);
+int fixed_record_save(const char *filename, const FixedRecordLayout *layout,
+                      const void *records, size_t count);
+size_t fixed_record_load(const char *filename, const FixedRecordLayout *layout,
+                         void *records, size_t capacity);
+int fixed_record_map_open(FixedRecordMap *map, const char *filename, const FixedRecordLayout *layout);
+void fixed_record_map_close(FixedRecordMap *map);
+
+#endif
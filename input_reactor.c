@@ -0,0 +1,236 @@
+/*
+ * input_reactor.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * epoll-based reactor that turns input into state machine events.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include "input_reactor.h"
+#include "terminal.h"
+
+#define REACTOR_MAX_EVENTS 16
+
+// Create the epoll instance, returns 1 on success, 0 on failure
+int reactor_init(Reactor *r)
+{
+    if (!r) return 0;
+
+    r->sources = NULL;
+    r->keyboard_queue = NULL;
+    r->epfd = epoll_create1(EPOLL_CLOEXEC);
+    return r->epfd >= 0;
+}
+
+/*
+ * reactor_add - watch fd for input
+ * @r: reactor
+ * @fd: descriptor (pipe, socket, timerfd, stdin, ...)
+ * @handler: called when fd is readable (or closed)
+ * @context: passed to the handler
+ * @flags: REACTOR_CLOSE_FD / REACTOR_FREE_CONTEXT, cleanup done on removal
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int reactor_add(Reactor *r, int fd, ReactorHandler handler, void *context, int flags)
+{
+    if (!r || fd < 0 || !handler) return 0;
+
+    ReactorSource *source = malloc(sizeof(ReactorSource));
+    if (!source) return 0;
+
+    source->fd = fd;
+    source->handler = handler;
+    source->context = context;
+    source->flags = flags;
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = source };
+    if (epoll_ctl(r->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        perror("epoll_ctl");
+        free(source);
+        return 0;
+    }
+
+    source->next = r->sources;
+    r->sources = source;
+    return 1;
+}
+
+/*
+ * reactor_remove - stop watching fd
+ * Returns: 1 on success, 0 if fd is not watched
+ */
+int reactor_remove(Reactor *r, int fd)
+{
+    if (!r) return 0;
+
+    for (ReactorSource **link = &r->sources; *link; link = &(*link)->next) {
+        ReactorSource *source = *link;
+        if (source->fd != fd) continue;
+
+        epoll_ctl(r->epfd, EPOLL_CTL_DEL, fd, NULL);
+        if (source->flags & REACTOR_CLOSE_FD) close(fd);
+        if (source->flags & REACTOR_FREE_CONTEXT) free(source->context);
+        if (fd == STDIN_FILENO) terminal_restore();
+
+        *link = source->next;
+        free(source);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * reactor_run_once - sleep until input arrives and call the handlers
+ * @r: reactor
+ * @timeout_ms: maximum time to sleep, -1 = no limit
+ *
+ * Returns: number of handlers called, 0 on timeout, -1 on error
+ */
+int reactor_run_once(Reactor *r, int timeout_ms)
+{
+    struct epoll_event events[REACTOR_MAX_EVENTS];
+
+    int n = epoll_wait(r->epfd, events, REACTOR_MAX_EVENTS, timeout_ms);
+    if (n < 0) return errno == EINTR ? 0 : -1;
+
+    for (int i = 0; i < n; i++) {
+        ReactorSource *source = events[i].data.ptr;
+        if (!source->handler(source->fd, events[i].events, source->context))
+            reactor_remove(r, source->fd);
+    }
+    return n;
+}
+
+// Remove all sources, close the epoll instance and restore the terminal
+void reactor_free(Reactor *r)
+{
+    if (!r) return;
+
+    while (r->sources)
+        reactor_remove(r, r->sources->fd);
+
+    if (r->epfd >= 0) close(r->epfd);
+    r->epfd = -1;
+    terminal_restore();
+}
+
+/* Keyboard handler: one read() per readiness, keys are mapped to events
+   's' = start, 'p' = stop, 'x' = shutdown */
+static int keyboard_handler(int fd, uint32_t events, void *context)
+{
+    EventQueue *q = context;
+    char keys[64];
+
+    ssize_t n = read(fd, keys, sizeof(keys));
+    if (n <= 0) {
+        // end of input: nothing more will come, ask the machine to stop
+        if (n == 0 || !(events & EPOLLIN)) event_queue_push(q, EVENT_SHUTDOWN, 0);
+        return n < 0 && errno == EINTR;
+    }
+
+    for (ssize_t i = 0; i < n; i++) {
+        switch (keys[i]) {
+            case 's': case 'S': event_queue_push(q, EVENT_START, 0); break;
+            case 'p': case 'P': event_queue_push(q, EVENT_STOP, 0); break;
+            case 'x': case 'X': event_queue_push(q, EVENT_SHUTDOWN, 0); break;
+            default: break;
+        }
+    }
+    return 1;
+}
+
+/*
+ * reactor_watch_keyboard - deliver key presses on stdin as events to q
+ * The terminal is put in raw mode and restored when stdin is removed,
+ * in reactor_free and at exit()
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int reactor_watch_keyboard(Reactor *r, EventQueue *q)
+{
+    if (!r || !q) return 0;
+
+    terminal_raw_mode(1);
+    if (!reactor_add(r, STDIN_FILENO, keyboard_handler, q, 0)) {
+        terminal_restore();
+        return 0;
+    }
+    r->keyboard_queue = q;
+    return 1;
+}
+
+/* Timer context: where to push which event */
+typedef struct {
+    EventQueue *q;
+    EventType   type;
+} TimerTarget;
+
+static int timer_handler(int fd, uint32_t events, void *context)
+{
+    TimerTarget *target = context;
+    uint64_t expirations;
+    (void)events;
+
+    if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+        return errno == EAGAIN || errno == EINTR;
+
+    event_queue_push(target->q, target->type, 0);
+    return 1;
+}
+
+/*
+ * reactor_add_timer - push an event every interval_ms milliseconds (timerfd)
+ * Returns: 1 on success, 0 on failure
+ */
+int reactor_add_timer(Reactor *r, int interval_ms, EventQueue *q, EventType type)
+{
+    if (!r || !q || interval_ms <= 0) return 0;
+
+    TimerTarget *target = malloc(sizeof(TimerTarget));
+    if (!target) return 0;
+    target->q = q;
+    target->type = type;
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        free(target);
+        return 0;
+    }
+
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = interval_ms / 1000;
+    spec.it_interval.tv_nsec = (interval_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+
+    if (timerfd_settime(fd, 0, &spec, NULL) != 0 || !reactor_add(r, fd, timer_handler, target, REACTOR_CLOSE_FD | REACTOR_FREE_CONTEXT)) {
+        close(fd);
+        free(target);
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,70 @@
+/*
+ * input_reactor.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Small epoll-based input reactor.
+ * user_pressed_exit_nonblocking() makes a read() syscall on every guard check,
+ * even when nothing was typed. The reactor instead sleeps in epoll_wait() on
+ * all the input file descriptors (keyboard, pipes, timerfds, sockets) and
+ * turns readiness into state machine events, so syscalls are only made when
+ * there is input.
+ */
+
+#ifndef INPUT_REACTOR_H
+#define INPUT_REACTOR_H
+
+#include <stdint.h>
+#include "event_queue.h"
+
+/* Called when fd is ready
+   - events: epoll events (EPOLLIN, EPOLLHUP, ...)
+   - returns 1 to keep watching fd, 0 to remove it from the reactor */
+typedef int (*ReactorHandler)(int fd, uint32_t events, void *context);
+
+/* What the reactor cleans up when a source is removed */
+#define REACTOR_CLOSE_FD      1   // close(fd)
+#define REACTOR_FREE_CONTEXT  2   // free(context)
+
+typedef struct ReactorSource {
+    int                   fd;
+    ReactorHandler        handler;
+    void                 *context;
+    int                   flags;    // REACTOR_CLOSE_FD | REACTOR_FREE_CONTEXT
+    struct ReactorSource *next;
+} ReactorSource;
+
+typedef struct {
+    int            epfd;            // the epoll instance
+    ReactorSource *sources;         // all watched descriptors
+    EventQueue    *keyboard_queue;  // where key presses go (NULL = keyboard not watched)
+} Reactor;
+
+int reactor_init(Reactor *r);
+void reactor_free(Reactor *r);
+int reactor_add(Reactor *r, int fd, ReactorHandler handler, void *context, int flags);
+int reactor_remove(Reactor *r, int fd);
+int reactor_run_once(Reactor *r, int timeout_ms);
+
+int reactor_watch_keyboard(Reactor *r, EventQueue *q);
+int reactor_add_timer(Reactor *r, int interval_ms, EventQueue *q, EventType type);
+
+#endif
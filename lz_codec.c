@@ -0,0 +1,200 @@
+/*
+ * lz_codec.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * LZ77-style block codec used by the compressed Person block format.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "lz_codec.h"
+
+#define MIN_MATCH    4
+#define MAX_OFFSET   65535
+#define HASH_BITS    12
+#define LAST_LITERALS 5     // the end of the block is always stored as literals
+
+static inline uint32_t read32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// hash of the 4 bytes at p, used to find earlier occurrences
+static inline uint32_t hash4(const unsigned char *p)
+{
+    return (read32(p) * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/*
+ * write_length - write the extension bytes of a length that did not fit in 4 bits
+ * Returns: pointer after the written bytes
+ */
+static unsigned char *write_length(unsigned char *out, size_t length)
+{
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = (unsigned char)length;
+    return out;
+}
+
+/*
+ * write_sequence - literals followed by a match (match_length 0 = literals only)
+ * Returns: pointer after the sequence
+ */
+static unsigned char *write_sequence(unsigned char *out, const unsigned char *literals,
+                                     size_t literal_count, size_t offset, size_t match_length)
+{
+    unsigned char *token = out++;
+    size_t match_code = match_length ? match_length - MIN_MATCH : 0;
+
+    *token = (unsigned char)(((literal_count < 15 ? literal_count : 15) << 4) |
+                             (match_code < 15 ? match_code : 15));
+
+    if (literal_count >= 15) out = write_length(out, literal_count - 15);
+    memcpy(out, literals, literal_count);
+    out += literal_count;
+
+    if (match_length) {
+        *out++ = (unsigned char)(offset & 0xFF);
+        *out++ = (unsigned char)(offset >> 8);
+        if (match_code >= 15) out = write_length(out, match_code - 15);
+    }
+    return out;
+}
+
+/*
+ * lz_compress - compress size bytes from src into dst
+ * @src: input
+ * @size: number of input bytes
+ * @dst: output buffer
+ * @capacity: size of dst, at least LZ_COMPRESS_BOUND(size)
+ *
+ * Returns: number of compressed bytes, 0 if dst is too small
+ */
+size_t lz_compress(const unsigned char *src, size_t size, unsigned char *dst, size_t capacity)
+{
+    if (capacity < LZ_COMPRESS_BOUND(size)) return 0;
+
+    // positions (+1, so 0 means empty) of the last occurrence of every hash
+    uint32_t table[1 << HASH_BITS] = {0};
+    const unsigned char *anchor = src;      // start of the pending literals
+    const unsigned char *p = src;
+    const unsigned char *end = src + size;
+    unsigned char *out = dst;
+
+    while (size > LAST_LITERALS + MIN_MATCH && p + MIN_MATCH + LAST_LITERALS <= end) {
+        uint32_t h = hash4(p);
+        const unsigned char *candidate = table[h] ? src + table[h] - 1 : NULL;
+        table[h] = (uint32_t)(p - src) + 1;
+
+        if (!candidate || p - candidate > MAX_OFFSET || read32(candidate) != read32(p)) {
+            p++;
+            continue;
+        }
+
+        // extend the match as far as it goes (but keep the last literals)
+        size_t length = MIN_MATCH;
+        while (p + length < end - LAST_LITERALS && candidate[length] == p[length])
+            length++;
+
+        out = write_sequence(out, anchor, p - anchor, p - candidate, length);
+        p += length;
+        anchor = p;
+    }
+
+    // the rest is stored as literals
+    out = write_sequence(out, anchor, end - anchor, 0, 0);
+    return out - dst;
+}
+
+/*
+ * read_length - read the extension bytes of a length
+ * Returns: 1 on success, 0 if the input ends in the middle
+ */
+static int read_length(const unsigned char **in, const unsigned char *end, size_t *length)
+{
+    unsigned char b;
+    do {
+        if (*in >= end) return 0;
+        b = *(*in)++;
+        *length += b;
+    } while (b == 255);
+    return 1;
+}
+
+/*
+ * lz_decompress - decompress a block produced by lz_compress
+ * @src: compressed data
+ * @size: number of compressed bytes
+ * @dst: output buffer
+ * @raw_size: expected number of decompressed bytes
+ *
+ * Returns: 1 on success, 0 if the data is corrupt
+ */
+int lz_decompress(const unsigned char *src, size_t size, unsigned char *dst, size_t raw_size)
+{
+    const unsigned char *in = src;
+    const unsigned char *in_end = src + size;
+    unsigned char *out = dst;
+    unsigned char *out_end = dst + raw_size;
+
+    while (in < in_end) {
+        unsigned char token = *in++;
+
+        // literals
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !read_length(&in, in_end, &literal_count)) return 0;
+        if (literal_count > (size_t)(in_end - in) || literal_count > (size_t)(out_end - out)) return 0;
+        memcpy(out, in, literal_count);
+        in += literal_count;
+        out += literal_count;
+
+        // the last sequence has no match
+        if (in == in_end) break;
+
+        // match
+        if (in_end - in < 2) return 0;
+        size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+
+        size_t length = token & 0x0F;
+        if (length == 15 && !read_length(&in, in_end, &length)) return 0;
+        length += MIN_MATCH;
+
+        if (offset == 0 || offset > (size_t)(out - dst) || length > (size_t)(out_end - out)) return 0;
+
+        // byte by byte, because the match may overlap the bytes it produces
+        const unsigned char *match = out - offset;
+        if (offset >= length) {
+            memcpy(out, match, length);
+            out += length;
+        } else {
+            while (length--) *out++ = *match++;
+        }
+    }
+
+    return out == out_end;
+}
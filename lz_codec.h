@@ -0,0 +1,44 @@
+/*
+ * lz_codec.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Small LZ77-style block codec (same idea as LZ4, no external library).
+ * A compressed block is a list of sequences:
+ *   token   - high 4 bits: number of literals, low 4 bits: match length - 4
+ *             (the value 15 means more length bytes follow, each adding 0..255)
+ *   literals
+ *   offset  - uint16, distance back to the match
+ * The last sequence has only literals.
+ */
+
+#ifndef LZ_CODEC_H
+#define LZ_CODEC_H
+
+#include <stddef.h>
+
+// worst-case size of the compressed data for n input bytes
+#define LZ_COMPRESS_BOUND(n) ((n) + (n) / 255 + 16)
+
+size_t lz_compress(const unsigned char *src, size_t size, unsigned char *dst, size_t capacity);
+int lz_decompress(const unsigned char *src, size_t size, unsigned char *dst, size_t raw_size);
+
+#endif
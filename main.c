@@ -28,6 +28,8 @@
 #include "read_binary_file.h"
 #include "unions.h"
 #include "states.h"
+#include "person_mmap.h"
+#include "states_events.h"
 
 
 // main 
@@ -42,9 +44,15 @@ int main(int argc, char* argv[])
 	// demonstration of writing binary files
 	// demo_write_binary();
 
+	// demonstration of reading a struct back from a file with a checked layout
+	// demo_read_binary_person();
+
 	// demonstration of reading and writing binary files with dynamic strings
 	// dynamic_file_main();
 
+	// demonstration of reading the same file with a memory-mapped view
+	// read_persons_from_file_mmap("people.bin");
+
 	// demonstration of unions
 	// unions_main();
 
@@ -57,5 +65,11 @@ int main(int argc, char* argv[])
 	// demonstration of simple state machine with transition table
 	main_transitions();
 
+	// demonstration of the event-driven state machine (sleeps while idle)
+	// main_events();
+
+	// demonstration of the same machine driven by an epoll input reactor
+	// main_reactor();
+
 	return 0;
 }
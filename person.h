@@ -0,0 +1,52 @@
+/*
+ * person.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Person record shared by the binary file examples.
+ * On disk every record is: uint32 name_len, int32 age, name bytes (no '\0').
+ */
+
+#ifndef PERSON_H
+#define PERSON_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+// Structure to hold person data with dynamically allocated name
+typedef struct {
+    uint32_t name_len;  // Length of the name string (for binary I/O)
+    int32_t  age;       // Age of the person
+    char    *name;      // Dynamically allocated name string
+} Person;
+
+// size of the on-disk header: name_len + age
+#define PERSON_HEADER_SIZE (sizeof(uint32_t) + sizeof(int32_t))
+
+int write_person(FILE *f, const Person *p);
+int read_person(FILE *f, Person *out);
+int free_person(Person *p);
+int read_person_arena(FILE *f, Person *out, Arena *arena);
+Person *load_persons_arena(const char *filename, Arena *arena, size_t *count);
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * person_block.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Writer and reader for the compressed Person block format.
+ * The reader decompresses one block at a time and returns the records as
+ * PersonView slices of the decompressed block.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "person_block.h"
+#include "lz_codec.h"
+
+/*
+ * grow - make sure the buffer has at least size bytes
+ * Returns: 1 on success, 0 on failure
+ */
+static int grow(unsigned char **buffer, size_t *capacity, size_t size)
+{
+    if (*capacity >= size) return 1;
+
+    unsigned char *bigger = realloc(*buffer, size);
+    if (!bigger) return 0;
+
+    *buffer = bigger;
+    *capacity = size;
+    return 1;
+}
+
+/*
+ * person_block_writer_open - create the file and write the file header
+ * Returns: pointer to the writer or NULL on failure
+ */
+PersonBlockWriter *person_block_writer_open(const char *filename)
+{
+    PersonBlockWriter *w = calloc(1, sizeof(PersonBlockWriter));
+    if (!w) return NULL;
+
+    w->f = fopen(filename, "wb");
+    if (!w->f) {
+        perror("fopen");
+        free(w);
+        return NULL;
+    }
+
+    PersonBlockFileHeader header = { PERSON_BLOCK_MAGIC, PERSON_BLOCK_VERSION };
+    if (fwrite(&header, sizeof(header), 1, w->f) != 1 ||
+        !grow(&w->raw, &w->raw_capacity, PERSON_BLOCK_SIZE) ||
+        !grow(&w->compressed, &w->compressed_capacity, LZ_COMPRESS_BOUND(PERSON_BLOCK_SIZE))) {
+        fclose(w->f);
+        free(w->raw);
+        free(w->compressed);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+/*
+ * flush_block - compress the current block and write it
+ * Returns: 1 on success, 0 on failure
+ */
+static int flush_block(PersonBlockWriter *w)
+{
+    if (w->records == 0) return 1;
+    if (!grow(&w->compressed, &w->compressed_capacity, LZ_COMPRESS_BOUND(w->raw_used))) return 0;
+
+    size_t stored = lz_compress(w->raw, w->raw_used, w->compressed, w->compressed_capacity);
+
+    // incompressible block - store it raw
+    const unsigned char *data = w->compressed;
+    if (stored == 0 || stored >= w->raw_used) {
+        data = w->raw;
+        stored = w->raw_used;
+    }
+
+    PersonBlockHeader header = { (uint32_t)w->raw_used, (uint32_t)stored, w->records };
+    if (fwrite(&header, sizeof(header), 1, w->f) != 1) return 0;
+    if (fwrite(data, 1, stored, w->f) != stored) return 0;
+
+    w->raw_used = 0;
+    w->records = 0;
+    return 1;
+}
+
+/*
+ * person_block_writer_append - add persons to the current block,
+ * a block is compressed and written when it reaches PERSON_BLOCK_SIZE
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int person_block_writer_append(PersonBlockWriter *w, const Person *persons, size_t count)
+{
+    if (!w || (!persons && count > 0)) return 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const Person *p = &persons[i];
+        if (!p->name) return 0;
+
+        size_t record_size = PERSON_HEADER_SIZE + p->name_len;
+
+        // the record does not fit any more - close the block first
+        if (w->raw_used > 0 && w->raw_used + record_size > PERSON_BLOCK_SIZE) {
+            if (!flush_block(w)) return 0;
+        }
+
+        // a single record bigger than a block gets a block of its own
+        if (!grow(&w->raw, &w->raw_capacity, w->raw_used + record_size)) return 0;
+
+        unsigned char *dst = w->raw + w->raw_used;
+        memcpy(dst, &p->name_len, sizeof(p->name_len));
+        memcpy(dst + sizeof(p->name_len), &p->age, sizeof(p->age));
+        memcpy(dst + PERSON_HEADER_SIZE, p->name, p->name_len);
+
+        w->raw_used += record_size;
+        w->records++;
+    }
+    return 1;
+}
+
+/*
+ * person_block_writer_close - write the last block and release the writer
+ * Returns: 1 on success, 0 on failure (the writer is released in both cases)
+ */
+int person_block_writer_close(PersonBlockWriter *w)
+{
+    if (!w) return 0;
+
+    int ok = flush_block(w);
+    if (fclose(w->f) != 0) ok = 0;
+
+    free(w->raw);
+    free(w->compressed);
+    free(w);
+    return ok;
+}
+
+/*
+ * person_block_reader_open - open a block file and check its header
+ * Returns: 1 on success, 0 on failure
+ */
+int person_block_reader_open(PersonBlockReader *r, const char *filename)
+{
+    if (!r) return 0;
+    memset(r, 0, sizeof(*r));
+
+    r->f = fopen(filename, "rb");
+    if (!r->f) {
+        perror("fopen");
+        return 0;
+    }
+
+    PersonBlockFileHeader header;
+    if (fread(&header, sizeof(header), 1, r->f) != 1 ||
+        header.magic != PERSON_BLOCK_MAGIC || header.version != PERSON_BLOCK_VERSION) {
+        fclose(r->f);
+        r->f = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * read_block - read and decompress the next block
+ * Returns: 1 on success, 0 at the end of the file or on corrupt data
+ */
+static int read_block(PersonBlockReader *r)
+{
+    PersonBlockHeader header;
+    if (fread(&header, sizeof(header), 1, r->f) != 1) return 0;
+    if (header.stored_size > header.raw_size) return 0;
+
+    if (!grow(&r->raw, &r->raw_capacity, header.raw_size)) return 0;
+
+    if (header.stored_size == header.raw_size) {
+        // stored raw
+        if (fread(r->raw, 1, header.raw_size, r->f) != header.raw_size) return 0;
+    } else {
+        if (!grow(&r->compressed, &r->compressed_capacity, header.stored_size)) return 0;
+        if (fread(r->compressed, 1, header.stored_size, r->f) != header.stored_size) return 0;
+        if (!lz_decompress(r->compressed, header.stored_size, r->raw, header.raw_size)) return 0;
+    }
+
+    r->raw_size = header.raw_size;
+    r->position = 0;
+    r->records_left = header.record_count;
+    return 1;
+}
+
+/*
+ * person_block_reader_next - next record of the file
+ * @r: reader
+ * @out: view of the record; it points into the current block and is valid
+ *       until the next call (copy the name if you need to keep it)
+ *
+ * Returns: 1 on success, 0 at the end of the file or on corrupt data
+ */
+int person_block_reader_next(PersonBlockReader *r, PersonView *out)
+{
+    if (!r || !r->f || !out) return 0;
+
+    // skip to the next non-empty block
+    while (r->records_left == 0) {
+        if (!read_block(r)) return 0;
+    }
+
+    size_t remaining = r->raw_size - r->position;
+    if (remaining < PERSON_HEADER_SIZE) return 0;
+
+    const unsigned char *p = r->raw + r->position;
+    memcpy(&out->name_len, p, sizeof(out->name_len));
+    memcpy(&out->age, p + sizeof(out->name_len), sizeof(out->age));
+    if (out->name_len > remaining - PERSON_HEADER_SIZE) return 0;
+
+    out->name = (const char *)(p + PERSON_HEADER_SIZE);
+    r->position += PERSON_HEADER_SIZE + out->name_len;
+    r->records_left--;
+    return 1;
+}
+
+// Close the file and release the buffers
+void person_block_reader_close(PersonBlockReader *r)
+{
+    if (!r) return;
+
+    if (r->f) fclose(r->f);
+    free(r->raw);
+    free(r->compressed);
+    memset(r, 0, sizeof(*r));
+}
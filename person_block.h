@@ -0,0 +1,87 @@
+/*
+ * person_block.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Compressed block container for Person records.
+ * File layout:
+ *   file header  - magic PERSON_BLOCK_MAGIC, version
+ *   blocks       - block header (raw size, stored size, record count) followed
+ *                  by the stored bytes
+ * Every block holds about PERSON_BLOCK_SIZE bytes of ordinary Person records
+ * (as written by write_person), compressed with lz_compress. A block that does
+ * not get smaller is stored raw (stored size == raw size).
+ */
+
+#ifndef PERSON_BLOCK_H
+#define PERSON_BLOCK_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "person.h"
+#include "person_mmap.h"
+
+#define PERSON_BLOCK_MAGIC   0x4B4C4250u    // "PBLK" in a little-endian file
+#define PERSON_BLOCK_VERSION 1u
+#define PERSON_BLOCK_SIZE    (64 * 1024)    // target size of the raw records in a block
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+} PersonBlockFileHeader;
+
+typedef struct {
+    uint32_t raw_size;          // bytes of records after decompression
+    uint32_t stored_size;       // bytes following the header in the file
+    uint32_t record_count;      // number of records in the block
+} PersonBlockHeader;
+
+typedef struct {
+    FILE          *f;
+    unsigned char *raw;         // records of the current block (uncompressed)
+    size_t         raw_used;
+    size_t         raw_capacity;
+    uint32_t       records;     // records in the current block
+    unsigned char *compressed;  // compression output
+    size_t         compressed_capacity;
+} PersonBlockWriter;
+
+typedef struct {
+    FILE          *f;
+    unsigned char *raw;         // decompressed records of the current block
+    size_t         raw_size;
+    size_t         raw_capacity;
+    size_t         position;    // next record in raw
+    uint32_t       records_left;
+    unsigned char *compressed;
+    size_t         compressed_capacity;
+} PersonBlockReader;
+
+PersonBlockWriter *person_block_writer_open(const char *filename);
+int person_block_writer_append(PersonBlockWriter *w, const Person *persons, size_t count);
+int person_block_writer_close(PersonBlockWriter *w);
+
+int person_block_reader_open(PersonBlockReader *r, const char *filename);
+int person_block_reader_next(PersonBlockReader *r, PersonView *out);
+void person_block_reader_close(PersonBlockReader *r);
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * person_index.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Offset index footer for Person files, which gives O(1) access to record #n
+ * instead of parsing the n-1 headers in front of it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "person_index.h"
+#include "person_varint.h"
+
+/*
+ * write_person_index - append the index block and the trailer
+ * @f: file positioned right after the last record
+ * @offsets: file offset of each record
+ * @count: number of records
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int write_person_index(FILE *f, const uint64_t *offsets, uint64_t count)
+{
+    if (!f || (!offsets && count > 0)) return 0;
+
+    if (count > 0 && fwrite(offsets, sizeof(uint64_t), count, f) != count) return 0;
+
+    PersonIndexTrailer trailer = { count, PERSON_INDEX_VERSION, PERSON_INDEX_MAGIC };
+    if (fwrite(&trailer, sizeof(trailer), 1, f) != 1) return 0;
+
+    return 1;
+}
+
+/*
+ * check_trailer - check that the trailer describes a footer that fits in the file
+ * Returns: 1 and the start of the index block if it does, 0 otherwise
+ */
+static int check_trailer(const PersonIndexTrailer *t, uint64_t file_size, uint64_t *index_start)
+{
+    if (t->magic != PERSON_INDEX_MAGIC || t->version != PERSON_INDEX_VERSION) return 0;
+
+    uint64_t footer_size = PERSON_INDEX_TRAILER_SIZE;
+    if (t->record_count > (file_size - footer_size) / sizeof(uint64_t)) return 0;
+    footer_size += t->record_count * sizeof(uint64_t);
+
+    *index_start = file_size - footer_size;
+    return 1;
+}
+
+/*
+ * person_index_find - look for the footer at the end of the file
+ * @f: file opened in binary read mode
+ * @count: number of indexed records (output)
+ * @index_start: offset of the index block, i.e. the end of the records (output)
+ *
+ * Returns: 1 if the file has a valid footer, 0 otherwise (old file format)
+ * The file position is restored in both cases.
+ */
+int person_index_find(FILE *f, uint64_t *count, uint64_t *index_start)
+{
+    if (!f || !count || !index_start) return 0;
+
+    long position = ftell(f);
+    if (position < 0 || fseek(f, 0, SEEK_END) != 0) return 0;
+
+    long file_size = ftell(f);
+    int found = 0;
+
+    if (file_size >= (long)PERSON_INDEX_TRAILER_SIZE) {
+        PersonIndexTrailer t;
+        if (fseek(f, file_size - (long)PERSON_INDEX_TRAILER_SIZE, SEEK_SET) == 0 &&
+            fread(&t, sizeof(t), 1, f) == 1 &&
+            check_trailer(&t, (uint64_t)file_size, index_start)) {
+            *count = t.record_count;
+            found = 1;
+        }
+    }
+
+    fseek(f, position, SEEK_SET);
+    return found;
+}
+
+/*
+ * person_index_find_mem - same as person_index_find, for a file in memory
+ * (e.g. mapped with person_map_open)
+ */
+int person_index_find_mem(const unsigned char *data, size_t size,
+                          uint64_t *count, uint64_t *index_start)
+{
+    if (!data || !count || !index_start || size < PERSON_INDEX_TRAILER_SIZE) return 0;
+
+    PersonIndexTrailer t;
+    memcpy(&t, data + size - PERSON_INDEX_TRAILER_SIZE, sizeof(t));
+    if (!check_trailer(&t, size, index_start)) return 0;
+
+    *count = t.record_count;
+    return 1;
+}
+
+/*
+ * person_index_open - load the index footer of a Person file
+ * @f: file opened in binary read mode, used by read_person_at afterwards
+ *
+ * Returns: index to pass to read_person_at, or NULL if the file has no
+ * valid footer (old file format) or on failure; release with person_index_close
+ * The file header and the offsets are read once here, so a lookup does not
+ * touch them again.
+ */
+PersonIndex *person_index_open(FILE *f)
+{
+    uint64_t count, index_start;
+    if (!person_index_find(f, &count, &index_start)) return NULL;
+    if (count > SIZE_MAX / sizeof(uint64_t) - 1) return NULL;
+
+    PersonIndex *index = malloc(sizeof(PersonIndex));
+    if (!index) return NULL;
+    index->file = f;
+    index->count = count;
+    index->offsets = malloc((size_t)(count + 1) * sizeof(uint64_t));
+    if (!index->offsets) {
+        free(index);
+        return NULL;
+    }
+
+    // the file header (versioned files) tells how the records are encoded
+    int ok = fseek(f, 0, SEEK_SET) == 0 && person_file_read_header(f, &index->encoding) &&
+             fseek(f, (long)index_start, SEEK_SET) == 0 &&
+             fread(index->offsets, sizeof(uint64_t), (size_t)count, f) == count;
+    index->offsets[count] = index_start;
+
+    // records are stored in order, so each one ends where the next one starts
+    for (uint64_t n = 0; ok && n < count; n++)
+        if (index->offsets[n] >= index->offsets[n + 1]) ok = 0;
+
+    if (!ok) {
+        person_index_close(index);
+        return NULL;
+    }
+    return index;
+}
+
+// Release an index (the file stays open)
+void person_index_close(PersonIndex *index)
+{
+    if (!index) return;
+    free(index->offsets);
+    free(index);
+}
+
+/*
+ * read_person_at - read record #n using the index
+ * @index: index from person_index_open
+ * @n: record number, starting from 0
+ * @out: pointer to Person structure to fill (name is allocated as in read_person)
+ *
+ * Returns: 1 on success, 0 on failure or if n is out of range
+ * The record size follows from the next offset, so the whole record is read
+ * with one seek and one read into the buffer that becomes the name.
+ */
+int read_person_at(const PersonIndex *index, uint64_t n, Person *out)
+{
+    if (!index || !out || n >= index->count) return 0;
+
+    uint64_t size = index->offsets[n + 1] - index->offsets[n];
+    // Sanity check: prevent allocation of unreasonably large strings
+    if (size > PERSON_FIELDS_MAX_BYTES + 1024 * 1024) return 0;
+
+    unsigned char *record = malloc((size_t)size + 1);
+    if (!record) return 0;
+    if (fseek(index->file, (long)index->offsets[n], SEEK_SET) != 0 ||
+        fread(record, 1, (size_t)size, index->file) != size) {
+        free(record);
+        return 0;
+    }
+
+    // name_len and age in front of the name
+    size_t fields;
+    uint32_t values[2];
+    if (index->encoding == PERSON_ENCODING_VARINT) {
+        if (varint_decode_u32(record, (size_t)size, values, 2, &fields) != 2) fields = 0;
+        values[1] = (uint32_t)zigzag_decode(values[1]);
+    } else {
+        fields = size >= PERSON_HEADER_SIZE ? PERSON_HEADER_SIZE : 0;
+        if (fields) memcpy(values, record, PERSON_HEADER_SIZE);
+    }
+    if (fields == 0 || values[0] != size - fields) {
+        free(record);
+        return 0;
+    }
+
+    out->name_len = values[0];
+    out->age = (int32_t)values[1];
+    memmove(record, record + fields, out->name_len);
+    record[out->name_len] = '\0';
+    out->name = (char *)record;
+    return 1;
+}
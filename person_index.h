@@ -0,0 +1,70 @@
+/*
+ * person_index.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Optional offset index at the end of a Person file.
+ * Layout of the footer (after the last record):
+ *   uint64 offset[record_count]   - file offset of every record
+ *   uint64 record_count
+ *   uint32 version
+ *   uint32 magic                  - PERSON_INDEX_MAGIC, the last 4 bytes of the file
+ * Files without the footer are plain Person files and are read sequentially.
+ * person_index_open loads the offsets once; read_person_at is then one seek
+ * and one read per record.
+ */
+
+#ifndef PERSON_INDEX_H
+#define PERSON_INDEX_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "person.h"
+
+#define PERSON_INDEX_MAGIC   0x58444950u    // "PIDX" in a little-endian file
+#define PERSON_INDEX_VERSION 1u
+
+typedef struct {
+    uint64_t record_count;
+    uint32_t version;
+    uint32_t magic;
+} PersonIndexTrailer;
+
+#define PERSON_INDEX_TRAILER_SIZE sizeof(PersonIndexTrailer)
+
+// An open index: the offsets of all records, loaded from the footer
+typedef struct {
+    FILE     *file;         // not owned, the caller closes it
+    uint64_t  count;        // number of records
+    uint64_t *offsets;      // count + 1 entries, the last is the end of the records
+    uint8_t   encoding;     // PERSON_ENCODING_FIXED or PERSON_ENCODING_VARINT
+} PersonIndex;
+
+int write_person_index(FILE *f, const uint64_t *offsets, uint64_t count);
+int person_index_find(FILE *f, uint64_t *count, uint64_t *index_start);
+int person_index_find_mem(const unsigned char *data, size_t size,
+                          uint64_t *count, uint64_t *index_start);
+PersonIndex *person_index_open(FILE *f);
+void person_index_close(PersonIndex *index);
+int read_person_at(const PersonIndex *index, uint64_t n, Person *out);
+
+#endif
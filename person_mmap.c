@@ -0,0 +1,178 @@
+/*
+ * person_mmap.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Memory-mapped zero-copy reader for Person files.
+ * Both the old format written by write_person() (uint32 name_len, int32 age,
+ * name bytes) and versioned files (person_varint.h) are read.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "person.h"
+#include "person_mmap.h"
+#include "person_index.h"
+#include "person_varint.h"
+
+/*
+ * person_map_open - map the whole file read-only
+ * @filename: path to the Person file
+ * @map: map structure to fill
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int person_map_open(const char *filename, PersonMap *map)
+{
+    if (!filename || !map) return 0;
+
+    map->data = NULL;
+    map->size = 0;
+    map->records_size = 0;
+    map->records_start = 0;
+    map->encoding = PERSON_ENCODING_FIXED;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("fstat");
+        close(fd);
+        return 0;
+    }
+
+    // mmap cannot map 0 bytes, an empty file is just an empty map
+    if (st.st_size > 0) {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return 0;
+        }
+
+        // we scan the file from the beginning to the end
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+        map->data = data;
+        map->size = st.st_size;
+        map->records_size = st.st_size;
+
+        // skip the index footer if the file has one
+        uint64_t count, index_start;
+        if (person_index_find_mem(map->data, map->size, &count, &index_start))
+            map->records_size = index_start;
+
+        // versioned files: the records start after the file header
+        if (!person_file_parse_header(map->data, map->records_size, &map->encoding, &map->records_start)) {
+            fprintf(stderr, "%s: unsupported Person file version\n", filename);
+            munmap(data, st.st_size);
+            close(fd);
+            map->data = NULL;
+            map->size = 0;
+            map->records_size = 0;
+            return 0;
+        }
+    }
+
+    // the mapping stays valid after the file descriptor is closed
+    close(fd);
+    return 1;
+}
+
+// Unmap the file, all PersonView pointers become invalid
+void person_map_close(PersonMap *map)
+{
+    if (map && map->data) {
+        munmap((void *)map->data, map->size);
+        map->data = NULL;
+        map->size = 0;
+        map->records_size = 0;
+    }
+}
+
+void person_map_iter_init(const PersonMap *map, PersonMapIterator *it)
+{
+    it->map = map;
+    it->offset = map->records_start;
+}
+
+/*
+ * person_map_next - return the next record as a slice of the mapping
+ * @it: iterator
+ * @out: view to fill
+ *
+ * Returns: 1 on success, 0 at the end of the file or on a truncated record
+ */
+int person_map_next(PersonMapIterator *it, PersonView *out)
+{
+    if (!it || !it->map || !out) return 0;
+
+    size_t remaining = it->map->records_size - it->offset;
+    if (it->map->encoding == PERSON_ENCODING_VARINT) {
+        size_t used;
+        if (person_varint_decode_views(it->map->data + it->offset, remaining, out, 1, &used) != 1) return 0;
+        it->offset += used;
+        return 1;
+    }
+    if (remaining < PERSON_HEADER_SIZE) return 0;
+
+    // header fields are not aligned in the file, so we copy them out
+    const unsigned char *p = it->map->data + it->offset;
+    memcpy(&out->name_len, p, sizeof(out->name_len));
+    memcpy(&out->age, p + sizeof(out->name_len), sizeof(out->age));
+
+    // truncated record - the name does not fit in the rest of the file
+    if (out->name_len > remaining - PERSON_HEADER_SIZE) return 0;
+
+    out->name = (const char *)(p + PERSON_HEADER_SIZE);
+    it->offset += PERSON_HEADER_SIZE + out->name_len;
+    return 1;
+}
+
+/*
+ * read_persons_from_file_mmap - same output as read_persons_from_file,
+ * but using the memory-mapped reader
+ */
+void read_persons_from_file_mmap(const char *filename)
+{
+    PersonMap map;
+    if (!person_map_open(filename, &map)) return;
+
+    PersonMapIterator it;
+    PersonView v;
+
+    person_map_iter_init(&map, &it);
+    while (person_map_next(&it, &v)) {
+        // name is not null-terminated, so we print exactly name_len characters
+        printf("Read person: name=\"%.*s\" (len=%u), age=%d\n",
+               (int)v.name_len, v.name, v.name_len, v.age);
+    }
+
+    person_map_close(&map);
+}
@@ -0,0 +1,64 @@
+/*
+ * person_mmap.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Read-only memory-mapped view of a Person file (people.bin).
+ * Records are returned as borrowed slices into the mapping, so reading a record
+ * needs no malloc and no copying.
+ */
+
+#ifndef PERSON_MMAP_H
+#define PERSON_MMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// the whole file mapped into memory
+typedef struct {
+    const unsigned char *data;  // start of the mapping (NULL for an empty file)
+    size_t               size;  // size of the file in bytes
+    size_t       records_size;  // bytes holding records (excludes the index footer)
+    size_t      records_start;  // offset of the first record (after the file header)
+    uint8_t          encoding;  // PERSON_ENCODING_FIXED or PERSON_ENCODING_VARINT
+} PersonMap;
+
+// one record, borrowed from the mapping
+// Note! name is NOT null-terminated, always use name_len
+typedef struct {
+    int32_t     age;
+    uint32_t    name_len;
+    const char *name;           // points into the mapping, valid until person_map_close
+} PersonView;
+
+// position of the next record in the mapping
+typedef struct {
+    const PersonMap *map;
+    size_t           offset;
+} PersonMapIterator;
+
+int person_map_open(const char *filename, PersonMap *map);
+void person_map_close(PersonMap *map);
+void person_map_iter_init(const PersonMap *map, PersonMapIterator *it);
+int person_map_next(PersonMapIterator *it, PersonView *out);
+void read_persons_from_file_mmap(const char *filename);
+
+#endif
@@ -0,0 +1,305 @@
+/*
+ * person_parallel.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Parallel decoding of Person files.
+ * 1) the file is mapped and split into one chunk per thread at record boundaries
+ *    taken from the index footer - no thread has to walk the records first;
+ * 2) the row of every chunk is known from the split, and for fixed records also
+ *    its name bytes, so each thread decodes its chunk straight into its own
+ *    slice of the PersonTable columns - the slices are in file order, so no
+ *    merge is needed. Varint records take two parallel passes: the first writes
+ *    the ages and counts the name bytes of each chunk, the second (after a
+ *    prefix sum over the chunks) copies the names.
+ * Without the footer the records can only be found one after another, so a
+ * plain file is loaded by one thread (person_table_load) and more than one
+ * thread is refused.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "person.h"
+#include "person_mmap.h"
+#include "person_index.h"
+#include "person_parallel.h"
+#include "person_varint.h"
+
+// varint records decoded per call of person_varint_decode_views
+#define DECODE_BATCH 256
+
+// one chunk of the file, decoded by one thread
+typedef struct {
+    const unsigned char *data;      // the mapped file
+    size_t      start;              // offset of the first record of the chunk
+    size_t      end;                // offset right after the last record
+    size_t      first_row;          // row of the first record in the table
+    size_t      rows;               // number of records in the chunk
+    size_t      name_start;         // offset of the first name in the name blob
+    size_t      name_bytes;         // name bytes of the chunk (varint: from the first pass)
+    PersonTable *table;             // destination
+    int         ok;                 // 1 if the chunk was decoded completely
+} DecodeChunk;
+
+typedef void *(*ChunkFunction)(void *chunk);
+
+/*
+ * split_with_index - chunk boundaries from the index footer, no scanning needed
+ * Returns: 1 on success, 0 if the file has no (usable) footer
+ */
+static int split_with_index(const PersonMap *map, DecodeChunk *chunks, int threads)
+{
+    uint64_t count, index_start;
+    if (!person_index_find_mem(map->data, map->size, &count, &index_start)) return 0;
+
+    const unsigned char *index = map->data + index_start;
+
+    for (int c = 0; c < threads; c++) {
+        uint64_t first = count * c / threads;
+        uint64_t last = count * (c + 1) / threads;
+        uint64_t start = index_start, end = index_start;
+
+        if (first < count) memcpy(&start, index + first * sizeof(uint64_t), sizeof(uint64_t));
+        if (last < count) memcpy(&end, index + last * sizeof(uint64_t), sizeof(uint64_t));
+        if (start > end || end > index_start) return 0;
+
+        chunks[c].start = start;
+        chunks[c].end = end;
+        chunks[c].rows = last - first;
+    }
+    return 1;
+}
+
+// Thread function: decode one chunk of fixed records into its slice of the table
+static void *decode_chunk(void *arg)
+{
+    DecodeChunk *chunk = arg;
+    PersonTable *t = chunk->table;
+    const unsigned char *p = chunk->data + chunk->start;
+    const unsigned char *end = chunk->data + chunk->end;
+    size_t row = chunk->first_row;
+    size_t name_offset = chunk->name_start;
+
+    chunk->ok = 0;
+    for (size_t i = 0; i < chunk->rows; i++) {
+        uint32_t name_len;
+        int32_t age;
+
+        if ((size_t)(end - p) < PERSON_HEADER_SIZE) return NULL;
+        memcpy(&name_len, p, sizeof(name_len));
+        memcpy(&age, p + sizeof(name_len), sizeof(age));
+        p += PERSON_HEADER_SIZE;
+        if (name_len > (size_t)(end - p)) return NULL;
+
+        t->ages[row] = age;
+        t->name_offsets[row] = (uint32_t)name_offset;
+        memcpy(t->names + name_offset, p, name_len);
+
+        p += name_len;
+        name_offset += name_len;
+        row++;
+    }
+
+    chunk->ok = (p == end);
+    return NULL;
+}
+
+// Thread function, first varint pass: the ages and the name bytes of a chunk
+static void *scan_varint_chunk(void *arg)
+{
+    DecodeChunk *chunk = arg;
+    const unsigned char *p = chunk->data + chunk->start;
+    size_t size = chunk->end - chunk->start, position = 0;
+    size_t row = chunk->first_row, last = chunk->first_row + chunk->rows;
+    PersonView views[DECODE_BATCH];
+
+    chunk->ok = 0;
+    chunk->name_bytes = 0;
+    while (row < last) {
+        size_t want = last - row < DECODE_BATCH ? last - row : DECODE_BATCH;
+        size_t used;
+        size_t n = person_varint_decode_views(p + position, size - position, views, want, &used);
+        if (n == 0) return NULL;
+
+        for (size_t i = 0; i < n; i++) {
+            chunk->table->ages[row + i] = views[i].age;
+            chunk->name_bytes += views[i].name_len;
+        }
+        row += n;
+        position += used;
+    }
+
+    chunk->ok = (position == size);
+    return NULL;
+}
+
+// Thread function, second varint pass: the name offsets and the names of a chunk
+static void *copy_varint_chunk(void *arg)
+{
+    DecodeChunk *chunk = arg;
+    PersonTable *t = chunk->table;
+    const unsigned char *p = chunk->data + chunk->start;
+    size_t size = chunk->end - chunk->start, position = 0;
+    size_t row = chunk->first_row, last = chunk->first_row + chunk->rows;
+    size_t name_offset = chunk->name_start;
+    PersonView views[DECODE_BATCH];
+
+    // the first pass checked the records, this one only has to follow them
+    while (row < last) {
+        size_t want = last - row < DECODE_BATCH ? last - row : DECODE_BATCH;
+        size_t used;
+        size_t n = person_varint_decode_views(p + position, size - position, views, want, &used);
+        if (n == 0) break;
+
+        for (size_t i = 0; i < n; i++) {
+            t->name_offsets[row + i] = (uint32_t)name_offset;
+            memcpy(t->names + name_offset, views[i].name, views[i].name_len);
+            name_offset += views[i].name_len;
+        }
+        row += n;
+        position += used;
+    }
+    return NULL;
+}
+
+/*
+ * run_chunks - call function for every chunk, one thread per chunk
+ * The calling thread takes the first chunk; chunks that do not get a thread
+ * are run by the calling thread as well.
+ */
+static void run_chunks(DecodeChunk *chunks, int threads, ChunkFunction function)
+{
+    pthread_t workers[PERSON_PARALLEL_MAX_THREADS];
+    int started = 1;
+
+    for (int c = 1; c < threads; c++, started++) {
+        if (pthread_create(&workers[c], NULL, function, &chunks[c]) != 0) break;
+    }
+    function(&chunks[0]);
+
+    for (int c = started; c < threads; c++)
+        function(&chunks[c]);
+
+    for (int c = 1; c < started; c++)
+        pthread_join(workers[c], NULL);
+}
+
+/*
+ * resize_table - make the columns exactly rows / name_bytes big
+ * Returns: 1 on success, 0 on failure
+ */
+static int resize_table(PersonTable *t, size_t rows, size_t name_bytes)
+{
+    int32_t *ages = realloc(t->ages, (rows ? rows : 1) * sizeof(int32_t));
+    if (!ages) return 0;
+    t->ages = ages;
+
+    uint32_t *offsets = realloc(t->name_offsets, (rows + 1) * sizeof(uint32_t));
+    if (!offsets) return 0;
+    t->name_offsets = offsets;
+
+    char *names = realloc(t->names, name_bytes ? name_bytes : 1);
+    if (!names) return 0;
+    t->names = names;
+
+    t->capacity = rows ? rows : 1;
+    t->names_capacity = name_bytes ? name_bytes : 1;
+    return 1;
+}
+
+/*
+ * person_table_load_parallel - load a Person file with several threads
+ * @t: empty table created with person_table_init
+ * @filename: path to the Person file (fixed or varint records)
+ * @threads: number of decoding threads (1..PERSON_PARALLEL_MAX_THREADS)
+ *
+ * Returns: 1 on success, 0 on failure, or if more than one thread is asked
+ * for and the file has no index footer
+ * The result is the same as person_table_load, rows are in file order.
+ */
+int person_table_load_parallel(PersonTable *t, const char *filename, int threads)
+{
+    if (!t || t->count != 0) return 0;
+    if (threads < 1) threads = 1;
+    if (threads > PERSON_PARALLEL_MAX_THREADS) threads = PERSON_PARALLEL_MAX_THREADS;
+
+    PersonMap map;
+    if (!person_map_open(filename, &map)) return 0;
+    if (map.records_size <= map.records_start) {
+        person_map_close(&map);
+        return 1;
+    }
+
+    // 1) find the record boundaries
+    DecodeChunk chunks[PERSON_PARALLEL_MAX_THREADS];
+    if (!split_with_index(&map, chunks, threads)) {
+        person_map_close(&map);
+        return threads == 1 ? person_table_load(t, filename) : 0;
+    }
+
+    int varint = map.encoding == PERSON_ENCODING_VARINT;
+    int ok = 1;
+    size_t rows = 0;
+    for (int c = 0; c < threads; c++) {
+        chunks[c].data = map.data;
+        chunks[c].table = t;
+        chunks[c].first_row = rows;
+        rows += chunks[c].rows;
+
+        // fixed records: whatever is not a header is a name
+        size_t bytes = chunks[c].end - chunks[c].start;
+        size_t headers = chunks[c].rows * PERSON_HEADER_SIZE;
+        if (!varint && bytes < headers) ok = 0;
+        chunks[c].name_bytes = varint || !ok ? 0 : bytes - headers;
+    }
+
+    // varint: the ages first, which also gives the name bytes of every chunk
+    if (ok && varint) {
+        ok = resize_table(t, rows, 0);
+        if (ok) run_chunks(chunks, threads, scan_varint_chunk);
+        for (int c = 0; ok && c < threads; c++)
+            if (!chunks[c].ok) ok = 0;
+    }
+
+    // 2) place every chunk in the name blob: name bytes before it
+    size_t name_bytes = 0;
+    for (int c = 0; ok && c < threads; c++) {
+        chunks[c].name_start = name_bytes;
+        name_bytes += chunks[c].name_bytes;
+    }
+    if (!ok || name_bytes > UINT32_MAX || !resize_table(t, rows, name_bytes)) {
+        person_map_close(&map);
+        return 0;
+    }
+
+    // 3) decode the chunks in parallel
+    run_chunks(chunks, threads, varint ? copy_varint_chunk : decode_chunk);
+    for (int c = 0; !varint && c < threads; c++)
+        if (!chunks[c].ok) ok = 0;
+
+    t->count = ok ? rows : 0;
+    t->name_offsets[t->count] = ok ? (uint32_t)name_bytes : 0;
+
+    person_map_close(&map);
+    return ok;
+}
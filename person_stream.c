@@ -0,0 +1,300 @@
+/*
+ * person_stream.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Double-buffered streaming reader for Person files.
+ * The buffers are used in turns: the reader thread fills buffer 0, then 1,
+ * then 0 again as soon as the consumer has released it, and so on.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "person_stream.h"
+#include "person_index.h"
+#include "person_varint.h"
+
+/*
+ * fill_buffer - read until the buffer is full or the records end
+ * Returns: number of bytes read, or -1 on error
+ */
+static ssize_t fill_buffer(PersonStream *s, unsigned char *buffer)
+{
+    size_t wanted = s->buffer_size;
+    if (wanted > s->remaining) wanted = s->remaining;
+
+    size_t got = 0;
+    while (got < wanted) {
+        ssize_t n = read(s->fd, buffer + got, wanted - got);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) break;
+        got += n;
+    }
+
+    s->remaining -= got;
+    return got;
+}
+
+// Reader thread: fill the buffers in turns until the end of the records
+static void *reader_thread(void *arg)
+{
+    PersonStream *s = arg;
+    int next = 0;
+
+    while (1) {
+        // wait until the consumer has released the buffer
+        pthread_mutex_lock(&s->lock);
+        while (s->filled[next] && !s->stop)
+            pthread_cond_wait(&s->changed, &s->lock);
+        int stop = s->stop;
+        pthread_mutex_unlock(&s->lock);
+        if (stop) break;
+
+        // the slow part - done without holding the lock
+        ssize_t n = fill_buffer(s, s->buffers[next]);
+
+        pthread_mutex_lock(&s->lock);
+        if (n < 0) {
+            s->error = 1;
+        } else {
+            s->sizes[next] = n;
+            s->filled[next] = 1;
+            if (n == 0 || s->remaining == 0) s->eof = 1;
+        }
+        pthread_cond_broadcast(&s->changed);
+        int done = s->eof || s->error;
+        pthread_mutex_unlock(&s->lock);
+
+        if (done) break;
+        next ^= 1;
+    }
+    return NULL;
+}
+
+/*
+ * person_stream_open - open the file and start the reader thread
+ * @s: stream to initialize
+ * @filename: path to the Person file
+ * @buffer_size: size of each buffer, 0 means PERSON_STREAM_DEFAULT_BUFFER
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int person_stream_open(PersonStream *s, const char *filename, size_t buffer_size)
+{
+    if (!s || !filename) return 0;
+    memset(s, 0, sizeof(*s));
+    s->buffer_size = buffer_size ? buffer_size : PERSON_STREAM_DEFAULT_BUFFER;
+
+    // find where the records end (the index footer, if any, is not read)
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        perror("fopen");
+        return 0;
+    }
+    uint64_t count, records_end;
+    if (person_index_find(f, &count, &records_end)) {
+        s->remaining = records_end;
+    } else {
+        fseek(f, 0, SEEK_END);
+        s->remaining = ftell(f);
+    }
+
+    // versioned files: the records start after the file header
+    long start = 0;
+    if (fseek(f, 0, SEEK_SET) != 0 || !person_file_read_header(f, &s->encoding) ||
+        (start = ftell(f)) < 0 || (uint64_t)start > s->remaining) {
+        fprintf(stderr, "%s: unsupported Person file version\n", filename);
+        fclose(f);
+        return 0;
+    }
+    s->remaining -= start;
+    fclose(f);
+
+    s->fd = open(filename, O_RDONLY);
+    if (s->fd < 0) {
+        perror("open");
+        return 0;
+    }
+    if (lseek(s->fd, start, SEEK_SET) != start) {
+        perror("lseek");
+        close(s->fd);
+        return 0;
+    }
+    posix_fadvise(s->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    s->buffers[0] = malloc(s->buffer_size);
+    s->buffers[1] = malloc(s->buffer_size);
+    if (!s->buffers[0] || !s->buffers[1]) {
+        free(s->buffers[0]);
+        free(s->buffers[1]);
+        close(s->fd);
+        return 0;
+    }
+
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->changed, NULL);
+
+    if (pthread_create(&s->thread, NULL, reader_thread, s) != 0) {
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->changed);
+        free(s->buffers[0]);
+        free(s->buffers[1]);
+        close(s->fd);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * next_buffer - give the used-up buffer back to the reader thread
+ * and wait until the other one is filled
+ * Returns: 1 if there is a buffer with data, 0 at the end of the records or on error
+ */
+static int next_buffer(PersonStream *s)
+{
+    pthread_mutex_lock(&s->lock);
+
+    if (s->have_buffer) {
+        s->filled[s->current] = 0;
+        s->current ^= 1;
+        s->position = 0;
+        s->have_buffer = 0;
+        pthread_cond_broadcast(&s->changed);
+    }
+
+    while (!s->filled[s->current] && !s->eof && !s->error)
+        pthread_cond_wait(&s->changed, &s->lock);
+
+    if (s->filled[s->current] && s->sizes[s->current] > 0) {
+        s->have_buffer = 1;
+        s->current_size = s->sizes[s->current];
+    }
+
+    pthread_mutex_unlock(&s->lock);
+    return s->have_buffer;
+}
+
+/*
+ * stream_read - copy size bytes from the buffers, switching buffers as needed
+ * Returns: 1 on success, 0 at the end of the records or on error
+ */
+static int stream_read(PersonStream *s, void *dst, size_t size)
+{
+    unsigned char *out = dst;
+
+    while (size > 0) {
+        if (!s->have_buffer || s->position == s->current_size) {
+            if (!next_buffer(s)) return 0;
+        }
+
+        size_t chunk = s->current_size - s->position;
+        if (chunk > size) chunk = size;
+
+        memcpy(out, s->buffers[s->current] + s->position, chunk);
+        s->position += chunk;
+        out += chunk;
+        size -= chunk;
+    }
+    return 1;
+}
+
+// Read one LEB128 varint, byte by byte, returns 1 on success, 0 on failure
+static int stream_read_varint(PersonStream *s, uint32_t *value)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < VARINT_MAX_BYTES; i++) {
+        unsigned char c;
+        if (!stream_read(s, &c, 1)) return 0;
+
+        v |= (uint32_t)(c & 0x7F) << (7 * i);
+        if (!(c & 0x80)) {
+            *value = v;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * person_stream_next - read the next Person, same semantics as read_person
+ * @s: stream
+ * @out: pointer to Person structure to fill (free the name with free_person)
+ *
+ * Returns: 1 on success, 0 on failure or at the end of the file
+ */
+int person_stream_next(PersonStream *s, Person *out)
+{
+    if (!s || !out) return 0;
+
+    // 1) Read metadata (header): name length and age
+    if (s->encoding == PERSON_ENCODING_VARINT) {
+        uint32_t age;
+        if (!stream_read_varint(s, &out->name_len) || !stream_read_varint(s, &age)) return 0;
+        out->age = zigzag_decode(age);
+    } else {
+        if (!stream_read(s, &out->name_len, sizeof(out->name_len))) return 0;
+        if (!stream_read(s, &out->age, sizeof(out->age))) return 0;
+    }
+
+    // Sanity check: prevent allocation of unreasonably large strings
+    if (out->name_len > 1024 * 1024) return 0;
+
+    // 2) Allocate memory for the string (including null terminator)
+    out->name = malloc(out->name_len + 1);
+    if (!out->name) return 0;
+
+    // 3) Copy the actual string data (payload)
+    if (!stream_read(s, out->name, out->name_len)) {
+        free(out->name);
+        out->name = NULL;
+        return 0;
+    }
+
+    out->name[out->name_len] = '\0';
+    return 1;
+}
+
+// Stop the reader thread and release the buffers
+void person_stream_close(PersonStream *s)
+{
+    if (!s || !s->buffers[0]) return;
+
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->changed);
+    pthread_mutex_unlock(&s->lock);
+
+    pthread_join(s->thread, NULL);
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->changed);
+
+    free(s->buffers[0]);
+    free(s->buffers[1]);
+    s->buffers[0] = s->buffers[1] = NULL;
+    close(s->fd);
+}
@@ -0,0 +1,65 @@
+/*
+ * person_stream.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Streaming Person reader with two large buffers.
+ * A background thread fills the next buffer from the disk while the caller
+ * decodes records from the current one, so the decode loop does not wait for
+ * the disk on every buffer refill.
+ */
+
+#ifndef PERSON_STREAM_H
+#define PERSON_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "person.h"
+
+// default size of each of the two buffers (4 MB)
+#define PERSON_STREAM_DEFAULT_BUFFER (4 * 1024 * 1024)
+
+typedef struct {
+    int             fd;             // the file being read
+    uint8_t         encoding;       // record encoding (person_varint.h)
+    uint64_t        remaining;      // bytes of records the reader thread has not read yet
+    unsigned char  *buffers[2];     // the two buffers
+    size_t          sizes[2];       // bytes in each buffer
+    int             filled[2];      // 1 when the buffer is ready for the consumer
+    size_t          buffer_size;    // capacity of each buffer
+    int             current;        // buffer the consumer decodes from
+    int             have_buffer;    // consumer owns the current buffer
+    size_t          current_size;   // bytes in the current buffer
+    size_t          position;       // consumer position in the current buffer
+    int             eof;            // reader thread reached the end of the records
+    int             error;          // reader thread failed
+    int             stop;           // consumer asks the reader thread to exit
+    pthread_t       thread;         // the reader thread
+    pthread_mutex_t lock;           // protects filled, sizes, eof, error and stop
+    pthread_cond_t  changed;        // signalled when any of them changes
+} PersonStream;
+
+int person_stream_open(PersonStream *s, const char *filename, size_t buffer_size);
+int person_stream_next(PersonStream *s, Person *out);
+void person_stream_close(PersonStream *s);
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * person_table.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Columnar Person table and the age kernels working on it.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "person_table.h"
+#include "person_mmap.h"
+
+#define PERSON_TABLE_INITIAL_CAPACITY 1024
+
+// Create an empty table, returns 1 on success, 0 on failure
+int person_table_init(PersonTable *t)
+{
+    if (!t) return 0;
+
+    t->count = 0;
+    t->capacity = PERSON_TABLE_INITIAL_CAPACITY;
+    t->names_capacity = 16 * PERSON_TABLE_INITIAL_CAPACITY;
+    t->ages = malloc(t->capacity * sizeof(int32_t));
+    t->name_offsets = malloc((t->capacity + 1) * sizeof(uint32_t));
+    t->names = malloc(t->names_capacity);
+
+    if (!t->ages || !t->name_offsets || !t->names) {
+        person_table_free(t);
+        return 0;
+    }
+
+    t->name_offsets[0] = 0;
+    return 1;
+}
+
+// Release all the columns of the table
+void person_table_free(PersonTable *t)
+{
+    if (!t) return;
+
+    free(t->ages);
+    free(t->name_offsets);
+    free(t->names);
+    t->ages = NULL;
+    t->name_offsets = NULL;
+    t->names = NULL;
+    t->count = t->capacity = t->names_capacity = 0;
+}
+
+/*
+ * person_table_append - add one person at the end of the table
+ * @t: table
+ * @age: age of the person
+ * @name: name (does not need to be null-terminated)
+ * @name_len: length of the name
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int person_table_append(PersonTable *t, int32_t age, const char *name, uint32_t name_len)
+{
+    if (!t || (!name && name_len > 0)) return 0;
+
+    // grow the fixed-size columns by doubling
+    if (t->count == t->capacity) {
+        size_t capacity = 2 * t->capacity;
+        int32_t *ages = realloc(t->ages, capacity * sizeof(int32_t));
+        if (!ages) return 0;
+        t->ages = ages;
+
+        uint32_t *offsets = realloc(t->name_offsets, (capacity + 1) * sizeof(uint32_t));
+        if (!offsets) return 0;
+        t->name_offsets = offsets;
+
+        t->capacity = capacity;
+    }
+
+    // the offsets are 32-bit, so all names together must stay below 4 GB
+    size_t used = t->name_offsets[t->count];
+    if ((uint64_t)used + name_len > UINT32_MAX) return 0;
+
+    // grow the name blob by doubling
+    if (t->names_capacity - used < name_len) {
+        size_t capacity = 2 * t->names_capacity;
+        while (capacity - used < name_len) capacity *= 2;
+
+        char *names = realloc(t->names, capacity);
+        if (!names) return 0;
+        t->names = names;
+        t->names_capacity = capacity;
+    }
+
+    memcpy(t->names + used, name, name_len);
+    t->ages[t->count] = age;
+    t->name_offsets[t->count + 1] = (uint32_t)(used + name_len);
+    t->count++;
+    return 1;
+}
+
+/*
+ * person_table_load - load a Person file (people.bin) into an empty table
+ * @t: table created with person_table_init
+ * @filename: path to the Person file
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int person_table_load(PersonTable *t, const char *filename)
+{
+    PersonMap map;
+    if (!t || !person_map_open(filename, &map)) return 0;
+
+    PersonMapIterator it;
+    PersonView v;
+    int ok = 1;
+
+    person_map_iter_init(&map, &it);
+    while (ok && person_map_next(&it, &v))
+        ok = person_table_append(t, v.age, v.name, v.name_len);
+
+    person_map_close(&map);
+    return ok;
+}
+
+/*
+ * person_table_name - name of person i
+ * Returns: pointer to the name (NOT null-terminated), its length in name_len
+ */
+const char *person_table_name(const PersonTable *t, size_t i, uint32_t *name_len)
+{
+    if (!t || i >= t->count) return NULL;
+
+    if (name_len) *name_len = t->name_offsets[i + 1] - t->name_offsets[i];
+    return t->names + t->name_offsets[i];
+}
+
+/*
+ * in_range - branch-free check min_age <= age <= max_age
+ * Subtracting in unsigned arithmetic turns the two comparisons into one
+ */
+static inline uint32_t in_range(int32_t age, int32_t min_age, int32_t max_age)
+{
+    return (uint32_t)age - (uint32_t)min_age <= (uint32_t)max_age - (uint32_t)min_age;
+}
+
+// Number of persons with min_age <= age <= max_age
+size_t person_table_count_age(const PersonTable *t, int32_t min_age, int32_t max_age)
+{
+    if (!t || min_age > max_age) return 0;
+
+    const int32_t *ages = t->ages;
+    size_t count = 0;
+
+    for (size_t i = 0; i < t->count; i++)
+        count += in_range(ages[i], min_age, max_age);
+    return count;
+}
+
+/*
+ * person_table_age_min_max - smallest and largest age in the table
+ * Returns: 1 on success, 0 if the table is empty
+ */
+int person_table_age_min_max(const PersonTable *t, int32_t *min_age, int32_t *max_age)
+{
+    if (!t || t->count == 0 || !min_age || !max_age) return 0;
+
+    const int32_t *ages = t->ages;
+    int32_t lo = ages[0], hi = ages[0];
+
+    for (size_t i = 1; i < t->count; i++) {
+        lo = ages[i] < lo ? ages[i] : lo;
+        hi = ages[i] > hi ? ages[i] : hi;
+    }
+
+    *min_age = lo;
+    *max_age = hi;
+    return 1;
+}
+
+/*
+ * person_table_age_histogram - count the persons of every age
+ * @t: table
+ * @bins: bin_count counters, bins[a] gets the number of persons with age a;
+ *        ages below 0 go to bins[0], ages above bin_count-1 to the last bin
+ * @bin_count: number of bins
+ *
+ * Returns: 1 on success, 0 on failure (the bins are then all zero)
+ * Four partial histograms are used, so that runs of equal ages do not wait
+ * on the previous increment of the same counter.
+ */
+int person_table_age_histogram(const PersonTable *t, uint64_t *bins, size_t bin_count)
+{
+    if (!bins || bin_count == 0) return 0;
+    memset(bins, 0, bin_count * sizeof(uint64_t));
+    if (!t || bin_count > INT32_MAX) return 0;
+
+    uint64_t *partial = calloc(4 * bin_count, sizeof(uint64_t));
+    if (!partial) return 0;
+
+    const int32_t *ages = t->ages;
+    const int32_t last = (int32_t)(bin_count - 1);
+    size_t i = 0;
+
+    for (; i + 4 <= t->count; i += 4) {
+        for (size_t k = 0; k < 4; k++) {
+            int32_t a = ages[i + k];
+            a = a < 0 ? 0 : a;
+            a = a > last ? last : a;
+            partial[k * bin_count + a]++;
+        }
+    }
+    for (; i < t->count; i++) {
+        int32_t a = ages[i];
+        a = a < 0 ? 0 : a;
+        a = a > last ? last : a;
+        partial[a]++;
+    }
+
+    for (size_t b = 0; b < bin_count; b++)
+        bins[b] = partial[b] + partial[bin_count + b] +
+                  partial[2 * bin_count + b] + partial[3 * bin_count + b];
+
+    free(partial);
+    return 1;
+}
+
+/*
+ * person_table_filter_age - selection vector of persons with min_age <= age <= max_age
+ * @t: table
+ * @min_age, @max_age: inclusive age range
+ * @selection: output, room for t->count row numbers
+ *
+ * Returns: number of selected rows
+ * Every row number is written, but the output position only advances when
+ * the row matches - no branch on the data.
+ */
+size_t person_table_filter_age(const PersonTable *t, int32_t min_age, int32_t max_age,
+                               uint32_t *selection)
+{
+    if (!t || !selection || min_age > max_age) return 0;
+
+    const int32_t *ages = t->ages;
+    size_t selected = 0;
+
+    for (size_t i = 0; i < t->count; i++) {
+        selection[selected] = (uint32_t)i;
+        selected += in_range(ages[i], min_age, max_age);
+    }
+    return selected;
+}
@@ -0,0 +1,59 @@
+/*
+ * person_table.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Columnar (struct-of-arrays) in-memory table of persons.
+ * Instead of an array of Person structures, every field is stored in its own
+ * contiguous array, so a scan over the ages touches only the ages:
+ *   ages[i]                          - age of person i
+ *   names[name_offsets[i] .. name_offsets[i+1]) - name of person i (packed, no '\0')
+ */
+
+#ifndef PERSON_TABLE_H
+#define PERSON_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    size_t    count;            // number of persons
+    size_t    capacity;         // allocated entries in ages (name_offsets has one more)
+    int32_t  *ages;             // age column
+    uint32_t *name_offsets;     // count + 1 offsets into names
+    char     *names;            // all names packed one after another
+    size_t    names_capacity;   // allocated bytes in names
+} PersonTable;
+
+int person_table_init(PersonTable *t);
+void person_table_free(PersonTable *t);
+int person_table_append(PersonTable *t, int32_t age, const char *name, uint32_t name_len);
+int person_table_load(PersonTable *t, const char *filename);
+const char *person_table_name(const PersonTable *t, size_t i, uint32_t *name_len);
+
+// age kernels, written without branches in the loop body so the compiler can vectorize them
+size_t person_table_count_age(const PersonTable *t, int32_t min_age, int32_t max_age);
+int person_table_age_min_max(const PersonTable *t, int32_t *min_age, int32_t *max_age);
+int person_table_age_histogram(const PersonTable *t, uint64_t *bins, size_t bin_count);
+size_t person_table_filter_age(const PersonTable *t, int32_t min_age, int32_t max_age,
+                               uint32_t *selection);
+
+#endif
@@ -0,0 +1,368 @@
+/*
+ * person_varint.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Compact varint encoding of the Person header and the file header that
+ * selects it.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "person_varint.h"
+
+/*
+ * person_file_write_header - write the file header, must be the first thing in the file
+ * Returns: 1 on success, 0 on failure
+ */
+int person_file_write_header(FILE *f, uint8_t encoding)
+{
+    if (!f || encoding > PERSON_ENCODING_VARINT) return 0;
+
+    PersonFileHeader header = { PERSON_FILE_MAGIC, PERSON_FILE_VERSION, encoding, {0, 0} };
+    return fwrite(&header, sizeof(header), 1, f) == 1;
+}
+
+/*
+ * person_file_read_header - detect the file version at the start of the file
+ * @f: file opened in binary read mode, positioned at the beginning
+ * @encoding: encoding of the records (output)
+ *
+ * Returns: 1 on success, 0 on an unknown version or encoding
+ * Old files without a header are reported as PERSON_ENCODING_FIXED and the
+ * file position is put back to the first record.
+ */
+int person_file_read_header(FILE *f, uint8_t *encoding)
+{
+    if (!f || !encoding) return 0;
+
+    long start = ftell(f);
+    PersonFileHeader header;
+
+    if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != PERSON_FILE_MAGIC) {
+        // version 1: no header at all
+        fseek(f, start, SEEK_SET);
+        *encoding = PERSON_ENCODING_FIXED;
+        return 1;
+    }
+
+    if (header.version != PERSON_FILE_VERSION || header.encoding > PERSON_ENCODING_VARINT)
+        return 0;
+
+    *encoding = header.encoding;
+    return 1;
+}
+
+/*
+ * person_file_parse_header - person_file_read_header for a file in memory
+ * @data, @size: start of the file (e.g. a mapping)
+ * @encoding: encoding of the records (output)
+ * @header_size: bytes before the first record (output), 0 for old files
+ *
+ * Returns: 1 on success, 0 on an unknown version or encoding
+ */
+int person_file_parse_header(const unsigned char *data, size_t size, uint8_t *encoding, size_t *header_size)
+{
+    PersonFileHeader header;
+
+    *encoding = PERSON_ENCODING_FIXED;
+    *header_size = 0;
+    if (!data || size < sizeof(header)) return 1;
+
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != PERSON_FILE_MAGIC) return 1;
+    if (header.version != PERSON_FILE_VERSION || header.encoding > PERSON_ENCODING_VARINT)
+        return 0;
+
+    *encoding = header.encoding;
+    *header_size = sizeof(header);
+    return 1;
+}
+
+/*
+ * varint_encode_u32 - LEB128: 7 bits per byte, high bit set when more bytes follow
+ * Returns: number of bytes written to out (1..VARINT_MAX_BYTES)
+ */
+size_t varint_encode_u32(uint32_t value, unsigned char *out)
+{
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char)value;
+    return n;
+}
+
+// The 7-bit groups of the first length (1..5) bytes of word, put together
+static inline uint32_t varint_gather(uint64_t word, size_t length)
+{
+    // keep only the bytes of this varint
+    word &= (1ull << (8 * length)) - 1;
+
+    return (uint32_t)((word & 0x7F) |
+                      ((word >> 1) & 0x3F80) |
+                      ((word >> 2) & 0x1FC000) |
+                      ((word >> 3) & 0xFE00000) |
+                      ((word >> 4) & 0xF0000000));
+}
+
+/*
+ * decode_one_fast - decode one varint from 8 readable bytes without a loop
+ * The terminating byte is the first one with the high bit clear; it is found
+ * with one count-trailing-zeros, the 7-bit groups are then gathered with shifts.
+ * Returns: number of bytes used, 0 if the varint is longer than 5 bytes
+ */
+static inline size_t decode_one_fast(const unsigned char *p, uint32_t *value)
+{
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+
+    uint64_t stops = ~word & 0x8080808080808080ull;
+    if (stops == 0) return 0;
+
+    size_t length = (__builtin_ctzll(stops) >> 3) + 1;
+    if (length > VARINT_MAX_BYTES) return 0;
+
+    *value = varint_gather(word, length);
+    return length;
+}
+
+/*
+ * decode_two_fast - decode the two varints of a record header (name_len and
+ * age) from one 8-byte load: two count-trailing-zeros find both ends, no
+ * branch depends on the lengths
+ * Returns: bytes used by both, 0 if they do not end within the 8 bytes
+ */
+static inline size_t decode_two_fast(const unsigned char *p, uint32_t *first, uint32_t *second)
+{
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+
+    uint64_t stops = ~word & 0x8080808080808080ull;
+    uint64_t second_stop = stops & (stops - 1);
+    if (second_stop == 0) return 0;
+
+    size_t first_length = (__builtin_ctzll(stops) >> 3) + 1;
+    size_t length = (__builtin_ctzll(second_stop) >> 3) + 1;
+    if (first_length > VARINT_MAX_BYTES || length - first_length > VARINT_MAX_BYTES) return 0;
+
+    *first = varint_gather(word, first_length);
+    *second = varint_gather(word >> (8 * first_length), length - first_length);
+    return length;
+}
+
+// Byte-by-byte decoder, used near the end of the buffer
+static size_t decode_one_slow(const unsigned char *p, size_t size, uint32_t *value)
+{
+    uint32_t v = 0;
+    for (size_t i = 0; i < size && i < VARINT_MAX_BYTES; i++) {
+        v |= (uint32_t)(p[i] & 0x7F) << (7 * i);
+        if (!(p[i] & 0x80)) {
+            *value = v;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static inline size_t decode_one(const unsigned char *p, size_t size, uint32_t *value)
+{
+    return size >= 8 ? decode_one_fast(p, value) : decode_one_slow(p, size, value);
+}
+
+/*
+ * varint_decode_u32 - decode up to count varints
+ * @src, @size: input buffer
+ * @values: output, room for count values
+ * @consumed: number of input bytes used (output, may be NULL)
+ *
+ * Returns: number of decoded values
+ */
+size_t varint_decode_u32(const unsigned char *src, size_t size, uint32_t *values,
+                         size_t count, size_t *consumed)
+{
+    size_t position = 0, n = 0;
+
+    // fast path: single-byte varints (all small values), eight at a time
+    while (n + 8 <= count && position + 8 <= size) {
+        uint64_t word;
+        memcpy(&word, src + position, sizeof(word));
+        if (word & 0x8080808080808080ull) break;
+
+        for (int k = 0; k < 8; k++)
+            values[n + k] = (uint32_t)(word >> (8 * k)) & 0x7F;
+        n += 8;
+        position += 8;
+    }
+
+    for (; n < count; n++) {
+        size_t used = decode_one(src + position, size - position, &values[n]);
+        if (used == 0) break;
+        position += used;
+    }
+
+    if (consumed) *consumed = position;
+    return n;
+}
+
+/*
+ * person_varint_decode_views - decode varint-encoded records from memory
+ * @src, @size: records (e.g. a mapped file after the file header)
+ * @out: output views, the names point into src
+ * @max_records: room in out
+ * @consumed: number of input bytes used (output, may be NULL)
+ *
+ * Returns: number of decoded records
+ */
+size_t person_varint_decode_views(const unsigned char *src, size_t size, PersonView *out,
+                                  size_t max_records, size_t *consumed)
+{
+    size_t position = 0, n = 0;
+
+    while (n < max_records && position < size) {
+        const unsigned char *p = src + position;
+        size_t remaining = size - position;
+        uint32_t name_len, age;
+        size_t used;
+
+        // common case: both values fit in one byte - one test for both;
+        // otherwise both usually still end within one 8-byte load
+        if (remaining >= 2 && !((p[0] | p[1]) & 0x80)) {
+            name_len = p[0];
+            age = p[1];
+            used = 2;
+        } else {
+            used = remaining >= 8 ? decode_two_fast(p, &name_len, &age) : 0;
+        }
+        if (used == 0) {
+            uint32_t fields[2];
+            if (varint_decode_u32(p, remaining, fields, 2, &used) != 2) break;
+            name_len = fields[0];
+            age = fields[1];
+        }
+
+        if (name_len > remaining - used) break;
+
+        out[n].name_len = name_len;
+        out[n].age = zigzag_decode(age);
+        out[n].name = (const char *)(p + used);
+        position += used + name_len;
+        n++;
+    }
+
+    if (consumed) *consumed = position;
+    return n;
+}
+
+/*
+ * person_encode_fields - serialize name_len and age (the record without the name)
+ * @out: room for PERSON_FIELDS_MAX_BYTES
+ *
+ * Returns: number of bytes written
+ */
+size_t person_encode_fields(const Person *p, uint8_t encoding, unsigned char *out)
+{
+    if (encoding == PERSON_ENCODING_VARINT) {
+        size_t n = varint_encode_u32(p->name_len, out);
+        return n + varint_encode_u32(zigzag_encode(p->age), out + n);
+    }
+    memcpy(out, &p->name_len, sizeof(p->name_len));
+    memcpy(out + sizeof(p->name_len), &p->age, sizeof(p->age));
+    return PERSON_HEADER_SIZE;
+}
+
+/*
+ * write_person_encoded - write_person for the given encoding
+ * Returns: 1 on success, 0 on failure
+ */
+int write_person_encoded(FILE *f, const Person *p, uint8_t encoding)
+{
+    if (encoding == PERSON_ENCODING_FIXED) return write_person(f, p);
+    if (!f || !p || !p->name || encoding != PERSON_ENCODING_VARINT) return 0;
+
+    unsigned char header[PERSON_FIELDS_MAX_BYTES];
+    size_t n = person_encode_fields(p, encoding, header);
+
+    if (fwrite(header, 1, n, f) != n) return 0;
+    if (p->name_len > 0 && fwrite(p->name, 1, p->name_len, f) != p->name_len) return 0;
+    return 1;
+}
+
+// Read one varint from a file, returns 1 on success, 0 on failure or EOF
+static int read_varint(FILE *f, uint32_t *value)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < VARINT_MAX_BYTES; i++) {
+        int c = fgetc(f);
+        if (c == EOF) return 0;
+
+        v |= (uint32_t)(c & 0x7F) << (7 * i);
+        if (!(c & 0x80)) {
+            *value = v;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * read_person_fields - read name_len and age of the next record, not the name
+ * Returns: 1 on success, 0 on failure or EOF
+ */
+int read_person_fields(FILE *f, Person *out, uint8_t encoding)
+{
+    if (encoding == PERSON_ENCODING_VARINT) {
+        uint32_t age;
+        if (!read_varint(f, &out->name_len) || !read_varint(f, &age)) return 0;
+        out->age = zigzag_decode(age);
+        return 1;
+    }
+    if (fread(&out->name_len, sizeof(out->name_len), 1, f) != 1) return 0;
+    return fread(&out->age, sizeof(out->age), 1, f) == 1;
+}
+
+/*
+ * read_person_encoded - read_person for the given encoding
+ * Returns: 1 on success, 0 on failure or EOF (free the name with free_person)
+ */
+int read_person_encoded(FILE *f, Person *out, uint8_t encoding)
+{
+    if (encoding == PERSON_ENCODING_FIXED) return read_person(f, out);
+    if (!f || !out || encoding != PERSON_ENCODING_VARINT) return 0;
+
+    if (!read_person_fields(f, out, encoding)) return 0;
+
+    // Sanity check: prevent allocation of unreasonably large strings
+    if (out->name_len > 1024 * 1024) return 0;
+
+    out->name = malloc(out->name_len + 1);
+    if (!out->name) return 0;
+
+    if (out->name_len > 0 && fread(out->name, 1, out->name_len, f) != out->name_len) {
+        free(out->name);
+        out->name = NULL;
+        return 0;
+    }
+
+    out->name[out->name_len] = '\0';
+    return 1;
+}
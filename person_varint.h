@@ -0,0 +1,96 @@
+/*
+ * person_varint.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Versioned Person files with an optional compact (varint) record encoding.
+ * Old files have no file header and start directly with the first record
+ * (version 1, fixed encoding). New files start with PersonFileHeader:
+ *   magic     - PERSON_FILE_MAGIC (never a valid name_len in an old file)
+ *   version   - PERSON_FILE_VERSION
+ *   encoding  - PERSON_ENCODING_FIXED:  uint32 name_len, int32 age, name
+ *               PERSON_ENCODING_VARINT: LEB128 name_len, zigzag LEB128 age, name
+ * Every reader (read_persons_from_file, PersonMap and the PersonTable loaders,
+ * load_persons_arena, read_person_at, PersonStream) accepts all three forms;
+ * PersonWriter writes them with person_writer_set_encoding().
+ */
+
+#ifndef PERSON_VARINT_H
+#define PERSON_VARINT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "person.h"
+#include "person_mmap.h"
+
+#define PERSON_FILE_MAGIC   0x4E535250u     // "PRSN" in a little-endian file
+#define PERSON_FILE_VERSION 2
+
+#define PERSON_ENCODING_FIXED  0
+#define PERSON_ENCODING_VARINT 1
+
+// a uint32 takes at most 5 bytes as a varint
+#define VARINT_MAX_BYTES 5
+
+// name_len and age take at most this many bytes in either encoding
+#define PERSON_FIELDS_MAX_BYTES (2 * VARINT_MAX_BYTES)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  encoding;
+    uint8_t  reserved[2];
+} PersonFileHeader;
+
+int person_file_write_header(FILE *f, uint8_t encoding);
+int person_file_read_header(FILE *f, uint8_t *encoding);
+int person_file_parse_header(const unsigned char *data, size_t size, uint8_t *encoding, size_t *header_size);
+size_t person_encode_fields(const Person *p, uint8_t encoding, unsigned char *out);
+int read_person_fields(FILE *f, Person *out, uint8_t encoding);
+int write_person_encoded(FILE *f, const Person *p, uint8_t encoding);
+int read_person_encoded(FILE *f, Person *out, uint8_t encoding);
+
+size_t varint_encode_u32(uint32_t value, unsigned char *out);
+size_t varint_decode_u32(const unsigned char *src, size_t size, uint32_t *values,
+                         size_t count, size_t *consumed);
+size_t person_varint_decode_views(const unsigned char *src, size_t size, PersonView *out,
+                                  size_t max_records, size_t *consumed);
+
+// zigzag: small negative and positive numbers both become small unsigned numbers
+static inline uint32_t zigzag_encode(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t zigzag_decode(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// bytes of a varint, without encoding it
+static inline size_t varint_size_u32(uint32_t v)
+{
+    return 1 + (v >= 1u << 7) + (v >= 1u << 14) + (v >= 1u << 21) + (v >= 1u << 28);
+}
+
+// bytes of one record in the given encoding
+static inline size_t person_encoded_size(const Person *p, uint8_t encoding)
+{
+    if (encoding == PERSON_ENCODING_VARINT)
+        return varint_size_u32(p->name_len) + varint_size_u32(zigzag_encode(p->age)) + p->name_len;
+    return PERSON_HEADER_SIZE + p->name_len;
+}
+
+#endif
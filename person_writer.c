@@ -0,0 +1,273 @@
+/*
+ * person_writer.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Batched writer for Person records.
+ * The file format is exactly the same as the one produced by write_person(),
+ * so read_person() can read the files back without any changes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "person_writer.h"
+#include "person_index.h"
+#include "person_varint.h"
+
+/*
+ * write_all_iov - write all the io vectors, even if write is partial
+ * @fd: file descriptor
+ * @iov: array of io vectors (modified when the write is partial)
+ * @count: number of io vectors
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+static int write_all_iov(int fd, struct iovec *iov, int count)
+{
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+
+        // skip the vectors that were written completely
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+
+        // and move inside the one that was written partially
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+    return 1;
+}
+
+/*
+ * person_writer_open - create the file and the batch buffer
+ * @filename: path to the output file (truncated if it exists)
+ * @buffer_size: size of the batch buffer, 0 means PERSON_WRITER_DEFAULT_BUFFER
+ *
+ * Returns: pointer to the writer or NULL on failure
+ */
+PersonWriter *person_writer_open(const char *filename, size_t buffer_size)
+{
+    if (!filename) return NULL;
+    if (buffer_size < PERSON_HEADER_SIZE) buffer_size = PERSON_WRITER_DEFAULT_BUFFER;
+
+    PersonWriter *w = malloc(sizeof(PersonWriter));
+    if (!w) return NULL;
+
+    w->buffer = malloc(buffer_size);
+    if (!w->buffer) {
+        free(w);
+        return NULL;
+    }
+
+    w->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (w->fd < 0) {
+        perror("open");
+        free(w->buffer);
+        free(w);
+        return NULL;
+    }
+
+    w->used = 0;
+    w->capacity = buffer_size;
+    w->records = 0;
+    w->offset = 0;
+    w->index = NULL;
+    w->index_cap = 0;
+    w->encoding = PERSON_ENCODING_FIXED;
+    return w;
+}
+
+/*
+ * person_writer_open_indexed - like person_writer_open, but person_writer_close
+ * also writes the offset index footer (see person_index.h)
+ */
+PersonWriter *person_writer_open_indexed(const char *filename, size_t buffer_size)
+{
+    PersonWriter *w = person_writer_open(filename, buffer_size);
+    if (!w) return NULL;
+
+    w->index_cap = 1024;
+    w->index = malloc(w->index_cap * sizeof(uint64_t));
+    if (!w->index) {
+        close(w->fd);
+        free(w->buffer);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+/*
+ * remember_offset - store the offset of the record being appended
+ * Returns: 1 on success, 0 on failure
+ */
+static int remember_offset(PersonWriter *w, size_t record_size)
+{
+    if (w->index) {
+        // grow the index by doubling its size
+        if (w->records == w->index_cap) {
+            uint64_t *index = realloc(w->index, 2 * w->index_cap * sizeof(uint64_t));
+            if (!index) return 0;
+            w->index = index;
+            w->index_cap *= 2;
+        }
+        w->index[w->records] = w->offset;
+    }
+
+    w->offset += record_size;
+    w->records++;
+    return 1;
+}
+
+/*
+ * person_writer_flush - write the buffered records with one write call
+ * @w: writer
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int person_writer_flush(PersonWriter *w)
+{
+    if (!w) return 0;
+    if (w->used == 0) return 1;
+
+    struct iovec iov = { w->buffer, w->used };
+    if (!write_all_iov(w->fd, &iov, 1)) return 0;
+
+    w->used = 0;
+    return 1;
+}
+
+/*
+ * person_writer_set_encoding - write a versioned file (person_varint.h)
+ * @w: writer, before the first person_writer_append
+ * @encoding: PERSON_ENCODING_FIXED or PERSON_ENCODING_VARINT
+ *
+ * Returns: 1 on success, 0 on failure
+ * Without this call the file is an old file without a header (version 1).
+ */
+int person_writer_set_encoding(PersonWriter *w, uint8_t encoding)
+{
+    if (!w || w->records > 0 || w->offset > 0 || encoding > PERSON_ENCODING_VARINT) return 0;
+
+    PersonFileHeader header = { PERSON_FILE_MAGIC, PERSON_FILE_VERSION, encoding, {0, 0} };
+    memcpy(w->buffer, &header, sizeof(header));
+    w->used = sizeof(header);
+    w->offset = sizeof(header);
+    w->encoding = encoding;
+    return 1;
+}
+
+/*
+ * person_writer_append - serialize count persons into the batch buffer
+ * @w: writer
+ * @persons: array of persons
+ * @count: number of persons in the array
+ *
+ * Returns: 1 on success, 0 on failure
+ *
+ * The buffer is flushed when the next record does not fit. A record larger
+ * than the whole buffer is written directly with writev (buffer + header + name),
+ * so it is never copied.
+ */
+int person_writer_append(PersonWriter *w, const Person *persons, size_t count)
+{
+    if (!w || (!persons && count > 0)) return 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const Person *p = &persons[i];
+        if (!p->name) return 0;
+
+        unsigned char header[PERSON_FIELDS_MAX_BYTES];
+        size_t header_size = person_encode_fields(p, w->encoding, header);
+        size_t record_size = header_size + p->name_len;
+        if (!remember_offset(w, record_size)) return 0;
+
+        // the record does not fit into the buffer at all:
+        // write buffer, header and name in one writev call
+        if (record_size > w->capacity) {
+            struct iovec iov[3] = {
+                { w->buffer, w->used },
+                { header, header_size },
+                { p->name, p->name_len }
+            };
+            if (!write_all_iov(w->fd, iov, 3)) return 0;
+
+            w->used = 0;
+            continue;
+        }
+
+        // not enough space left - write the batch first
+        if (w->capacity - w->used < record_size) {
+            if (!person_writer_flush(w)) return 0;
+        }
+
+        // same layout as write_person_encoded: name_len, age, name bytes
+        unsigned char *dst = w->buffer + w->used;
+        memcpy(dst, header, header_size);
+        memcpy(dst + header_size, p->name, p->name_len);
+
+        w->used += record_size;
+    }
+    return 1;
+}
+
+/*
+ * person_writer_close - flush the remaining records and release the writer
+ * @w: writer
+ *
+ * Returns: 1 on success, 0 on failure (the writer is released in both cases)
+ */
+int person_writer_close(PersonWriter *w)
+{
+    if (!w) return 0;
+
+    int ok = person_writer_flush(w);
+
+    // index footer: offsets followed by the trailer
+    if (ok && w->index) {
+        PersonIndexTrailer trailer = { w->records, PERSON_INDEX_VERSION, PERSON_INDEX_MAGIC };
+        struct iovec iov[2] = {
+            { w->index, w->records * sizeof(uint64_t) },
+            { &trailer, sizeof(trailer) }
+        };
+        ok = write_all_iov(w->fd, iov, 2);
+    }
+
+    if (close(w->fd) != 0) ok = 0;
+
+    free(w->index);
+    free(w->buffer);
+    free(w);
+    return ok;
+}
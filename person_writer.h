@@ -0,0 +1,59 @@
+/*
+ * person_writer.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Batched writer for Person records.
+ * Instead of three fwrite calls per record (name_len, age, name) the records are
+ * serialized into one contiguous buffer and the buffer is written with a single
+ * write() per batch.
+ */
+
+#ifndef PERSON_WRITER_H
+#define PERSON_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "person.h"
+
+// default size of the batch buffer (1 MB)
+#define PERSON_WRITER_DEFAULT_BUFFER (1024 * 1024)
+
+typedef struct {
+    int            fd;          // file descriptor of the output file
+    unsigned char *buffer;      // serialized headers and names waiting to be written
+    size_t         used;        // number of bytes in the buffer
+    size_t         capacity;    // size of the buffer
+    uint64_t       records;     // number of records appended so far
+    uint64_t       offset;      // file offset of the next record
+    uint64_t      *index;       // record offsets for the index footer (NULL = no footer)
+    size_t         index_cap;   // allocated entries in index
+    uint8_t        encoding;    // record encoding (person_varint.h), fixed by default
+} PersonWriter;
+
+PersonWriter *person_writer_open(const char *filename, size_t buffer_size);
+PersonWriter *person_writer_open_indexed(const char *filename, size_t buffer_size);
+int person_writer_set_encoding(PersonWriter *w, uint8_t encoding);
+int person_writer_append(PersonWriter *w, const Person *persons, size_t count);
+int person_writer_flush(PersonWriter *w);
+int person_writer_close(PersonWriter *w);
+
+#endif
@@ -26,6 +26,7 @@
 #include <stdlib.h>		
 #include <stdio.h>		// Note! this is the header file which allows us to work with files
 #include <string.h>
+#include "fixed_record.h"
 #define MAX 20			// max number of characters to read
 
 struct sPerson {
@@ -33,6 +34,14 @@ struct sPerson {
 	int age;
 };
 
+// the layout of struct sPerson, stored in the header of a checked file,
+// see fixed_record.h
+static const FixedRecordLayout sPerson_layout = {
+	FIXED_RECORD_TYPE_SPERSON, sizeof(struct sPerson), 2,
+	{ FIXED_FIELD(struct sPerson, name),
+	  FIXED_FIELD(struct sPerson, age) }
+};
+
 // this function demonstrates how to write a series of integers to a binary file
 void demo_write_binary()
 {
@@ -64,6 +73,11 @@ void demo_write_binary()
 		strcpy(person.name, "John");
 		person.age = 25;
 		fwrite(&person, sizeof(person), 1, pBinaryFile);
+
+		// the same person in a file that starts with a description of the layout:
+		// a program compiled with other padding (or on a machine with another
+		// byte order) gets an error message instead of a garbled person
+		fixed_record_save("myPersonFile.bin", &sPerson_layout, &person, 1);
 	}
 	// if the file was not opened, just provide an error message
 	else
@@ -74,6 +88,24 @@ void demo_write_binary()
 	fclose(pBinaryFile);
 }
 
+// this function reads the person written by demo_write_binary back,
+// but only after the layout in the file header was checked
+void demo_read_binary_person()
+{
+	char* personFilename = "myPersonFile.bin";
+	struct sPerson person;
+
+	if (fixed_record_load(personFilename, &sPerson_layout, &person, 1) == 1)
+	{
+		// the name is always terminated, strcpy wrote it
+		printf("Person: %s, age %d\n", person.name, person.age);
+	}
+	else
+	{
+		printf("Error reading a person from file %s.", personFilename);
+	}
+}
+
 
 void demo_file_binary()
 {
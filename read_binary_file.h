@@ -24,4 +24,6 @@
 
 void demo_file_binary();
 
-void demo_write_binary();
\ No newline at end of file
+void demo_write_binary();
+
+void demo_read_binary_person();
\ No newline at end of file
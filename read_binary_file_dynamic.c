@@ -30,16 +30,13 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "person.h"
+#include "person_index.h"
+#include "arena.h"
+#include "person_varint.h"
 
 #define MAX_NAME_LENGTH 256
 
-// Structure to hold person data with dynamically allocated name
-typedef struct {
-    uint32_t name_len;  // Length of the name string (for binary I/O)
-    int32_t  age;       // Age of the person
-    char    *name;      // Dynamically allocated name string
-} Person;
-
 /*
  * write_person - Write a Person structure to a binary file
  * @f: file pointer (opened in binary write mode)
@@ -104,15 +101,123 @@ int read_person(FILE *f, Person *out)
     return 1;
 }
 
-// Free dynamically allocated memory from a Person structure
+/*
+ * read_person_arena_encoded - read_person_arena for the given record encoding
+ * Returns: 1 on success, 0 on failure or EOF
+ */
+static int read_person_arena_encoded(FILE *f, Person *out, Arena *arena, uint8_t encoding)
+{
+    if (!f || !out || !arena) return 0;
+
+    // 1) Read metadata (header): name length and age
+    if (!read_person_fields(f, out, encoding)) return 0;
+
+    // Sanity check: prevent allocation of unreasonably large strings
+    if (out->name_len > 1024 * 1024) return 0;
+
+    // 2) Take memory for the string from the arena (no malloc per record)
+    out->name = arena_alloc(arena, out->name_len + 1);
+    if (!out->name) return 0;
+
+    // 3) Read the actual string data (payload)
+    // on failure the memory simply stays in the arena until it is reset
+    if (out->name_len > 0) {
+        if (fread(out->name, 1, out->name_len, f) != out->name_len) {
+            out->name = NULL;
+            return 0;
+        }
+    }
+
+    out->name[out->name_len] = '\0';
+    return 1;
+}
+
+/*
+ * read_person_arena - same as read_person, but the name is taken from an arena
+ * @f: file pointer (opened in binary read mode)
+ * @out: pointer to Person structure to fill
+ * @arena: arena that owns the name; do NOT call free_person on the result
+ *
+ * Returns: 1 on success, 0 on failure or EOF
+ */
+int read_person_arena(FILE *f, Person *out, Arena *arena)
+{
+    return read_person_arena_encoded(f, out, arena, PERSON_ENCODING_FIXED);
+}
+
+/*
+ * load_persons_arena - read all persons of a file into one array
+ * @filename: path to the input file
+ * @arena: arena that owns all the names
+ * @count: number of persons read (output)
+ *
+ * Returns: array of persons (release with free()) or NULL on failure.
+ * The names are released with a single arena_reset/arena_free.
+ */
+Person *load_persons_arena(const char *filename, Arena *arena, size_t *count)
+{
+    if (!filename || !arena || !count) return NULL;
+    *count = 0;
+
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        perror("fopen");
+        return NULL;
+    }
+
+    // stop at the index footer, if there is one
+    uint64_t indexed, records_end = UINT64_MAX;
+    person_index_find(f, &indexed, &records_end);
+
+    // versioned files: skip the file header, the records may be varint-encoded
+    uint8_t encoding;
+    if (!person_file_read_header(f, &encoding)) {
+        fprintf(stderr, "%s: unsupported Person file version\n", filename);
+        fclose(f);
+        return NULL;
+    }
+
+    // we count the bytes ourselves, ftell per record would cost a syscall
+    long start = ftell(f);
+    uint64_t position = start < 0 ? 0 : (uint64_t)start;
+    size_t capacity = 1024;
+    Person *persons = malloc(capacity * sizeof(Person));
+
+    while (persons && position < records_end) {
+        // grow the array by doubling its size
+        if (*count == capacity) {
+            Person *bigger = realloc(persons, 2 * capacity * sizeof(Person));
+            if (!bigger) {
+                free(persons);
+                persons = NULL;
+                break;
+            }
+            persons = bigger;
+            capacity *= 2;
+        }
+
+        if (!read_person_arena_encoded(f, &persons[*count], arena, encoding))
+            break;
+        position += person_encoded_size(&persons[*count], encoding);
+        (*count)++;
+    }
+
+    fclose(f);
+    return persons;
+}
+
+/*
+ * free_person - free the name of a Person read with read_person
+ * Note! the Person structure itself is NOT freed, because it can live
+ * on the stack or in an array; free it separately if it was malloc'ed
+ *
+ * Returns: 0 if the name was freed, 1 if there was nothing to free
+ */
 int free_person(Person *p)
 {
     if (p && p->name) {
         free(p->name);
         p->name = NULL;  // Clear pointer to avoid use-after-free bugs
-
-        free(p);  // Free the Person structure itself   
-        p = NULL;
         return 0;
     }
     return 1;
@@ -209,6 +314,8 @@ int write_persons_to_file(const char *filename, const Person *p1, const Person *
  * @filename: path to the input file
  * 
  * Reads and displays all persons stored in the binary file
+ * If the file ends with an index footer, reading stops where the footer starts
+ * Both old files (no file header) and versioned files are accepted
  */
 void read_persons_from_file(const char *filename)
 {
@@ -218,17 +325,34 @@ void read_persons_from_file(const char *filename)
         return;
     }
 
-    // Read persons one by one until EOF
-    while (1) {
+    // Files with an index footer: the records end where the index starts
+    // Files without it: the records end at EOF
+    uint64_t count, records_end = UINT64_MAX;
+    person_index_find(f, &count, &records_end);
+
+    // The version header tells us how the records are encoded
+    uint8_t encoding;
+    if (!person_file_read_header(f, &encoding)) {
+        printf("Unsupported file version.\n");
+        fclose(f);
+        return;
+    }
+
+    // Read persons one by one until EOF (or the index footer)
+    // one ftell for the start, then we count the bytes ourselves
+    long start = ftell(f);
+    uint64_t position = start < 0 ? 0 : (uint64_t)start;
+    while (position < records_end) {
         Person p = {0};  // Initialize to zero
 
         // Attempt to read next person; break if EOF or error
-        if (!read_person(f, &p))
+        if (!read_person_encoded(f, &p, encoding))
             break;
 
         // Display the person's information
         printf("Read person: name=\"%s\" (len=%u), age=%d\n",
                p.name, p.name_len, p.age);
+        position += person_encoded_size(&p, encoding);
 
         // Clean up allocated memory
         free_person(&p);
@@ -242,8 +366,13 @@ int dynamic_file_main(void)
     const char *filename = "people.bin";
 
     // Create two person structures
-    Person *p1 = malloc(sizeof(Person));
-    Person *p2 = malloc(sizeof(Person));
+    Person *p1 = calloc(1, sizeof(Person));
+    Person *p2 = calloc(1, sizeof(Person));
+    if (!p1 || !p2) {
+        free(p1);
+        free(p2);
+        return 1;
+    }
 
     // Read person data from console
     read_persons_from_console(p1, p2);
@@ -252,12 +381,17 @@ int dynamic_file_main(void)
     if (!write_persons_to_file(filename, p1, p2)) {
         free_person(p1);
         free_person(p2);
+        free(p1);
+        free(p2);
         return 1;
     }
 
     // Clean up dynamically allocated memory
+    // first the names, then the Person structures themselves
     free_person(p1);
     free_person(p2);
+    free(p1);
+    free(p2);
 
     // Read and display persons from file
     read_persons_from_file(filename);
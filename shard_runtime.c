@@ -0,0 +1,251 @@
+/*
+ * shard_runtime.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Sharded multi-threaded execution of state machine instances with work stealing.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "shard_runtime.h"
+
+// Give every worker an equal, contiguous range of shards
+static void reset_queues(ShardRuntime *r)
+{
+    for (int w = 0; w < r->threads; w++) {
+        atomic_store_explicit(&r->queues[w].next, r->shard_count * w / r->threads,
+                              memory_order_relaxed);
+        r->queues[w].end = r->shard_count * (w + 1) / r->threads;
+    }
+}
+
+/*
+ * take_shard - claim the next shard of a queue
+ * Returns: 1 and the shard number, 0 if the queue is empty
+ */
+static int take_shard(ShardQueue *q, size_t *shard)
+{
+    // cheap check first, so that empty queues are not hammered with increments
+    if (atomic_load_explicit(&q->next, memory_order_relaxed) >= q->end) return 0;
+
+    size_t k = atomic_fetch_add_explicit(&q->next, 1, memory_order_relaxed);
+    if (k >= q->end) return 0;
+
+    *shard = k;
+    return 1;
+}
+
+/*
+ * work_run - all steps of a run, one shard at a time: own queue first,
+ * then steal from the others
+ * Shards do not share instances, so a shard can make all its steps without
+ * waiting for the others; the only barrier is at the end of the run.
+ */
+static void work_run(ShardWorker *worker)
+{
+    ShardRuntime *r = worker->runtime;
+    size_t shard;
+
+    while (take_shard(&r->queues[worker->id], &shard))
+        state_engine_run(&r->shards[shard], r->steps);
+
+    for (int v = 1; v < r->threads; v++) {
+        ShardQueue *victim = &r->queues[(worker->id + v) % r->threads];
+        while (take_shard(victim, &shard)) {
+            state_engine_run(&r->shards[shard], r->steps);
+            worker->stolen++;
+        }
+    }
+    pthread_barrier_wait(&r->done);
+}
+
+// Pool thread: wait for a run, work, repeat until stop
+static void *pool_thread(void *arg)
+{
+    ShardWorker *worker = arg;
+    ShardRuntime *r = worker->runtime;
+    unsigned seen = 0;
+
+    while (1) {
+        pthread_mutex_lock(&r->lock);
+        while (r->generation == seen && !r->stop)
+            pthread_cond_wait(&r->wake, &r->lock);
+        seen = r->generation;
+        int stop = r->stop;
+        pthread_mutex_unlock(&r->lock);
+
+        if (stop) break;
+        work_run(worker);
+    }
+    return NULL;
+}
+
+// Wake the pool threads and wait for them to exit
+static void stop_pool(ShardRuntime *r, int started)
+{
+    pthread_mutex_lock(&r->lock);
+    r->stop = 1;
+    pthread_cond_broadcast(&r->wake);
+    pthread_mutex_unlock(&r->lock);
+
+    for (int w = 1; w < started; w++)
+        pthread_join(r->pool[w], NULL);
+
+    pthread_mutex_destroy(&r->lock);
+    pthread_cond_destroy(&r->wake);
+    pthread_barrier_destroy(&r->done);
+}
+
+/*
+ * shard_runtime_init - create the shards and the worker pool
+ * @r: runtime to initialize
+ * @table, @count, @state_count: transition table (see StateEngine)
+ * @instance_count: total number of instances
+ * @shard_size: instances per shard, several shards per thread let stealing balance the load
+ * @threads: number of threads (including the caller); 0 = deterministic mode:
+ *           all shards are stepped in order on the calling thread
+ * @initial_state: state of all instances
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int shard_runtime_init(ShardRuntime *r, const Transition *table, size_t count, size_t state_count,
+                       size_t instance_count, size_t shard_size, int threads, State initial_state)
+{
+    if (!r || shard_size == 0) return 0;
+    memset(r, 0, sizeof(*r));
+
+    r->deterministic = (threads <= 0);
+    r->threads = r->deterministic ? 1 : threads;
+    if (r->threads > SHARD_RUNTIME_MAX_THREADS) r->threads = SHARD_RUNTIME_MAX_THREADS;
+
+    r->instance_count = instance_count;
+    r->shard_size = shard_size;
+    r->shard_count = (instance_count + shard_size - 1) / shard_size;
+    if (!transition_index_build(&r->index, table, count, state_count)) return 0;
+    r->shards = calloc(r->shard_count ? r->shard_count : 1, sizeof(StateEngine));
+    if (!r->shards) {
+        transition_index_free(&r->index);
+        return 0;
+    }
+
+    // one index for all shards: the transitions stay in the cache once
+    for (size_t k = 0; k < r->shard_count; k++) {
+        size_t first = k * shard_size;
+        size_t size = instance_count - first < shard_size ? instance_count - first : shard_size;
+        if (!state_engine_init_shared(&r->shards[k], &r->index, NULL, size, initial_state)) {
+            r->shard_count = k;
+            shard_runtime_free(r);
+            return 0;
+        }
+        r->shards[k].instance_base = (uint32_t)first;
+    }
+
+    for (int w = 0; w < r->threads; w++) {
+        r->workers[w].runtime = r;
+        r->workers[w].id = w;
+    }
+
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->wake, NULL);
+    pthread_barrier_init(&r->done, NULL, r->threads);
+
+    // worker 0 is the thread calling shard_runtime_run
+    for (int w = 1; w < r->threads; w++) {
+        if (pthread_create(&r->pool[w], NULL, pool_thread, &r->workers[w]) != 0) {
+            // without all threads the barrier would never open
+            stop_pool(r, w);
+            r->workers[0].runtime = NULL;
+            shard_runtime_free(r);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * shard_runtime_run - step every instance steps times
+ * Every shard makes its steps in one go (state_engine_run), so the threads
+ * meet once per run instead of once per step.
+ */
+void shard_runtime_run(ShardRuntime *r, size_t steps)
+{
+    if (!r || steps == 0) return;
+
+    if (r->deterministic) {
+        for (size_t k = 0; k < r->shard_count; k++)
+            state_engine_run(&r->shards[k], steps);
+        return;
+    }
+
+    reset_queues(r);
+
+    pthread_mutex_lock(&r->lock);
+    r->steps = steps;
+    r->generation++;
+    pthread_cond_broadcast(&r->wake);
+    pthread_mutex_unlock(&r->lock);
+
+    work_run(&r->workers[0]);
+}
+
+/*
+ * shard_runtime_shard - shard that owns an instance
+ * @local: index of the instance inside the shard (output)
+ */
+StateEngine *shard_runtime_shard(ShardRuntime *r, size_t instance, size_t *local)
+{
+    if (!r || instance >= r->instance_count) return NULL;
+    if (local) *local = instance % r->shard_size;
+    return &r->shards[instance / r->shard_size];
+}
+
+// Current state of an instance (call between runs)
+State shard_runtime_state(const ShardRuntime *r, size_t instance)
+{
+    if (!r || instance >= r->instance_count) return STATE_COUNT;
+    return r->shards[instance / r->shard_size].states[instance % r->shard_size];
+}
+
+// Number of shards stolen by all workers so far
+size_t shard_runtime_stolen(const ShardRuntime *r)
+{
+    size_t stolen = 0;
+    for (int w = 0; w < r->threads; w++)
+        stolen += r->workers[w].stolen;
+    return stolen;
+}
+
+// Stop the pool threads and release the shards
+void shard_runtime_free(ShardRuntime *r)
+{
+    if (!r) return;
+
+    // the pool exists once the workers are set up
+    if (r->workers[0].runtime)
+        stop_pool(r, r->threads);
+
+    for (size_t k = 0; k < r->shard_count; k++)
+        state_engine_free(&r->shards[k]);
+    free(r->shards);
+    transition_index_free(&r->index);
+    memset(r, 0, sizeof(*r));
+}
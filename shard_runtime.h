@@ -0,0 +1,88 @@
+/*
+ * shard_runtime.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Multi-core runtime for many state machine instances.
+ * The instances are split into shards; every shard is a StateEngine that owns
+ * its instances, so stepping a shard needs no locks. Each worker thread starts
+ * with its own range of shards and, when it runs out, steals shards from the
+ * other workers' ranges (one atomic increment per shard, no locks). Shards
+ * whose instances are busy (e.g. in STATE_MOVING with an expensive guard) then
+ * do not leave the other cores idle. A worker makes all steps of a run on a
+ * shard before it takes the next one, so the threads only meet at the end of
+ * the run, and the shard keeps its grouping by state from step to step.
+ * Guards are called from several threads at once, so they must be thread-safe.
+ */
+
+#ifndef SHARD_RUNTIME_H
+#define SHARD_RUNTIME_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "state_engine.h"
+
+#define SHARD_RUNTIME_MAX_THREADS 64
+
+// range of shards that starts with one worker; other workers may steal from it
+typedef struct {
+    _Alignas(64) atomic_size_t next;    // next shard to take (own cache line)
+    size_t end;
+} ShardQueue;
+
+typedef struct ShardRuntime ShardRuntime;
+
+// every worker on its own cache line: stolen is written on every steal
+typedef struct {
+    _Alignas(64) ShardRuntime *runtime;
+    int           id;
+    size_t        stolen;               // shards taken from other workers
+} ShardWorker;
+
+struct ShardRuntime {
+    TransitionIndex   index;            // compiled once, shared by all shards
+    StateEngine      *shards;
+    size_t            shard_count;
+    size_t            shard_size;       // instances per shard (the last one may be smaller)
+    size_t            instance_count;
+    int               threads;          // worker threads including the calling thread
+    int               deterministic;    // 1 = all shards in order on the calling thread
+    ShardQueue        queues[SHARD_RUNTIME_MAX_THREADS];
+    ShardWorker       workers[SHARD_RUNTIME_MAX_THREADS];
+    pthread_t         pool[SHARD_RUNTIME_MAX_THREADS];
+    pthread_mutex_t   lock;             // protects generation and stop
+    pthread_cond_t    wake;             // signalled when a run starts or the pool stops
+    unsigned          generation;       // incremented for every run
+    int               stop;             // pool threads exit
+    pthread_barrier_t done;             // all workers finished the run
+    size_t            steps;            // steps of the current run (made by every shard in one go)
+};
+
+int shard_runtime_init(ShardRuntime *r, const Transition *table, size_t count, size_t state_count,
+                       size_t instance_count, size_t shard_size, int threads, State initial_state);
+void shard_runtime_run(ShardRuntime *r, size_t steps);
+State shard_runtime_state(const ShardRuntime *r, size_t instance);
+StateEngine *shard_runtime_shard(ShardRuntime *r, size_t instance, size_t *local);
+size_t shard_runtime_stolen(const ShardRuntime *r);
+void shard_runtime_free(ShardRuntime *r);
+
+#endif
@@ -24,69 +24,39 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include "state_machine.h"
+#include "transition_table.h"
+#include "state_trace.h"
 
-/* Define states */
-typedef enum {
-    STATE_INIT,
-    STATE_STILL,
-    STATE_MOVING,
-    STATE_STOP,
-    STATE_COUNT
-} State;
-
-/* Transition table entry
-   - from: state where this transition is considered
-   - guard: function returning true when the transition should be taken
-   - to: next state if guard is true
-*/
-typedef struct {
-    State from;
-    bool (*guard)(void);
-    State to;
-} Transition;
-
-/* The transition table implements the state diagram:
-   [*] -> Init -> Still -> Moving -> Still
-                           \-> Stop -> [*]
-   We keep order so that shutdown (Moving -> Stop) is checked before stop_moving.
-*/
+/* The state diagram is the DEMO_TRANSITIONS list in state_machine.h */
+
+/* The transition table, generated from the list above */
 static const Transition transitions[] = {
-    
-    // format for each row: 
-    // from state, guard function, to state
-    { STATE_INIT,   NULL,           STATE_STILL },
-    { STATE_STILL,  start_moving,   STATE_MOVING },
-    { STATE_MOVING, shutdown,       STATE_STOP },
-    { STATE_MOVING, stop_moving,    STATE_STILL },
-    { STATE_STOP,   NULL,           STATE_STOP }
+    DEMO_TRANSITIONS(TRANSITION_ROW)
 };
 
-/* Helper: print state name */
-static const char *state_name(State s) {
-    switch (s) {
-        case STATE_INIT:   return "INIT";
-        case STATE_STILL:  return "STILL";
-        case STATE_MOVING: return "MOVING";
-        case STATE_STOP:   return "STOP";
-        default:           return "UNKNOWN";
-    }
-}
+/* The same machine as an inlined switch, generated from the same list */
+DEFINE_TRANSITION_DISPATCH(demo_dispatch, DEMO_TRANSITIONS)
+
+/* State names, generated from the state list in transition_table.h */
+#define STATE_NAME_ENTRY(name, arg) #name,
+const char *const state_names[STATE_COUNT] = {
+    STATE_LIST(STATE_NAME_ENTRY, _)
+};
 
-/* Table-driven state machine step
+/* Table-driven step over any transition table
    - Look for the first transition whose 'from' matches current_state and whose guard is true (or NULL)
    - If guard == NULL we treat it as unconditional (always true)
    - If no transition matches for the state, re-enter the same state (this keeps behavior similar to your original code)
+   transition_table_match returns the row that fires (count = none), transition_table_step the next state
 */
-State state_machine_step_transitions(State current_state) {
-    printf("State: %s\n", state_name(current_state));
-
+size_t transition_table_match(const Transition *table, size_t count, State current_state) {
     // Iterate transitions in order
-    // sizeof(transitions)/sizeof(transitions[0]) - number of entries in the table
-    for (size_t i = 0; i < sizeof(transitions)/sizeof(transitions[0]); ++i) {
+    for (size_t i = 0; i < count; ++i) {
 
         // Get pointer to current transition
-        const Transition *t = &transitions[i];
+        const Transition *t = &table[i];
 
         // Check if this transition is applicable for the current state
         if (t->from != current_state) continue;
@@ -94,19 +64,45 @@ State state_machine_step_transitions(State current_state) {
         // Check guard condition
         if (t->guard == NULL) {
             /* unconditional transition */
-            return t->to;
+            return i;
         } else {
             /* conditional transition */
             if (t->guard()) {
-                return t->to;
+                return i;
             }
         }
     }
 
+    // No transition matched
+    return count;
+}
+
+State transition_table_step(const Transition *table, size_t count, State current_state) {
+    size_t row = transition_table_match(table, count, current_state);
+
     // No transition matched: 
     // re-enter the same state 
     // (execute entry actions again in your model)
-    return current_state;
+    return row < count ? table[row].to : current_state;
+}
+
+/* Table-driven state machine step for the demo table
+   Nothing is printed here - at millions of steps per second a printf per step
+   would cost far more than the step itself. The transition is recorded in the
+   binary trace instead (when tracing is on). */
+State state_machine_step_transitions(State current_state) {
+    // sizeof(transitions)/sizeof(transitions[0]) - number of entries in the table
+    size_t count = sizeof(transitions)/sizeof(transitions[0]);
+    size_t row = transition_table_match(transitions, count, current_state);
+    if (row == count) return current_state;
+
+    state_trace(0, current_state, transitions[row].to, (uint32_t)row);
+    return transitions[row].to;
+}
+
+/* Compiled state machine step: same behavior, no table scan and no function pointers */
+State state_machine_step_compiled(State current_state) {
+    return demo_dispatch(current_state);
 }
 
 /* Main for the state machine demo */
@@ -117,10 +113,29 @@ int main_transitions(void) {
     printf("Note: user_pressed_exit() reads one character from stdin and returns true on 'x' or 'X'.\n");
     printf("Press 'x' then Enter to request shutdown when in MOVING.\n\n");
 
+    // tracing is opt-in: STATE_TRACE=transitions.trace ./lecture3 records every
+    // transition into that file, decode it with: ./trace_decode transitions.trace
+    const char *trace_name = getenv("STATE_TRACE");
+    if (trace_name && *trace_name) state_trace_enable(1);
+
+    printf("State: %s\n", state_name(state));
     while (state != STATE_STOP) {
-        state = state_machine_step_transitions(state);
+        State next = state_machine_step_transitions(state);
+
+        // the same machine without the table scan:
+        // State next = state_machine_step_compiled(state);
+
+        // print only the changes, not every step
+        if (next != state) printf("State: %s\n", state_name(next));
+        state = next;
     }
 
     printf("State machine terminated.\n");
+
+    if (trace_name && *trace_name) {
+        if (state_trace_dump(trace_name))
+            printf("Transitions written to %s\n", trace_name);
+        state_trace_free();
+    }
     return 0;
 }
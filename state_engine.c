@@ -0,0 +1,572 @@
+/*
+ * state_engine.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Batched multi-instance state machine engine.
+ * One step is synchronous: every instance makes one transition based on the
+ * state it had at the beginning of the step, with the same rules as
+ * transition_table_step (first match in table order, NULL guard is
+ * unconditional, no match = stay). Only the order in which guards are called
+ * differs - grouped by state instead of by instance.
+ * Timed transitions: an instance's timer starts when it enters the state that
+ * owns a timeout (or a state inheriting it from that parent) and is cancelled
+ * when it leaves it. Moving between substates of the owner, or staying in the
+ * same state (no match or a self-transition), does not restart it; a timed
+ * transition that fires restarts it.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "state_engine.h"
+
+/*
+ * state_engine_init - compile the table and create instance_count instances
+ * @e: engine to initialize
+ * @table, @count: transition table
+ * @state_count: number of states
+ * @instance_count: number of instances
+ * @initial_state: state of all instances
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int state_engine_init(StateEngine *e, const Transition *table, size_t count, size_t state_count,
+                      size_t instance_count, State initial_state)
+{
+    return state_engine_init_nested(e, table, count, NULL, state_count, instance_count, initial_state);
+}
+
+/*
+ * state_engine_init_nested - same as state_engine_init, with nested states
+ * @parents: parent of every state (-1 = top level), NULL = flat machine
+ *
+ * Returns: 1 on success, 0 on failure
+ * A state takes its own transitions first, then those of its parent and so on.
+ */
+int state_engine_init_nested(StateEngine *e, const Transition *table, size_t count,
+                             const int *parents, size_t state_count,
+                             size_t instance_count, State initial_state)
+{
+    TransitionIndex index;
+    if (!e || !transition_index_build_nested(&index, table, count, state_count, parents)) return 0;
+
+    if (!state_engine_init_shared(e, &index, parents, instance_count, initial_state)) {
+        transition_index_free(&index);
+        return 0;
+    }
+    e->shared_index = 0;    // built here, so this engine owns it
+    return 1;
+}
+
+/*
+ * state_engine_init_shared - create instances that use an index built elsewhere
+ * @index: compiled transitions, shared by all engines that use it (read only);
+ *         must stay valid until the engines are freed
+ * @parents: parent of every state (as for the index), NULL = flat machine
+ *
+ * Returns: 1 on success, 0 on failure
+ * Engines of one machine (e.g. shards) then keep a single copy of the
+ * transitions in the cache.
+ */
+int state_engine_init_shared(StateEngine *e, const TransitionIndex *index, const int *parents,
+                             size_t instance_count, State initial_state)
+{
+    if (!e || !index || instance_count > UINT32_MAX) return 0;
+    memset(e, 0, sizeof(*e));
+
+    e->index = *index;
+    e->shared_index = 1;
+    size_t state_count = index->state_count;
+
+    // batch guards are per compiled transition (a parent's transition appears once per child)
+    size_t compiled = e->index.offsets[state_count];
+    size_t slots = compiled ? compiled : 1;
+    size_t instances = instance_count ? instance_count : 1;
+    e->instance_count = instance_count;
+    e->batch_guards = calloc(slots, sizeof(BatchGuard));
+    e->batch_contexts = calloc(slots, sizeof(void *));
+    e->states = malloc(instances * sizeof(State));
+    e->order = malloc(instances * sizeof(uint32_t));
+    e->group_offsets = malloc((state_count + 1) * sizeof(uint32_t));
+    e->results = malloc(instances * sizeof(bool));
+
+    if (!e->batch_guards || !e->batch_contexts || !e->states || !e->order ||
+        !e->group_offsets || !e->results) {
+        state_engine_free(e);
+        return 0;
+    }
+
+    if (parents) {
+        e->parents = malloc((state_count ? state_count : 1) * sizeof(int));
+        if (!e->parents) {
+            state_engine_free(e);
+            return 0;
+        }
+        memcpy(e->parents, parents, state_count * sizeof(int));
+    }
+
+    for (size_t i = 0; i < instance_count; i++)
+        e->states[i] = initial_state;
+    return 1;
+}
+
+// Start (or cancel) the timer of an instance that has just entered state
+static inline void start_timer(StateEngine *e, uint32_t id, State state)
+{
+    uint32_t timeout = (size_t)state < e->index.state_count ? e->timeouts[state] : 0;
+
+    if (timeout)
+        timer_wheel_schedule(&e->timers, id, timeout);
+    else
+        timer_wheel_cancel(&e->timers, id);
+}
+
+// State whose timed transition applies in state (itself or a parent), -1 = none
+static inline int timeout_owner(const StateEngine *e, State state)
+{
+    return (size_t)state < e->index.state_count ? e->timeout_owners[state] : -1;
+}
+
+/*
+ * transition_hooks - the slow path of a transition: trace, actions, timers
+ * Only called when something is attached or tracing is on
+ */
+static void transition_hooks(StateEngine *e, uint32_t id, State from, State to, uint32_t row)
+{
+    size_t state_count = e->index.state_count;
+    int changed = to != from;
+
+    state_trace(e->instance_base + id, from, to, row);
+    if (changed) state_engine_mark_dirty(e, id);
+
+    if (changed && e->exit_actions && (size_t)from < state_count && e->exit_actions[from])
+        e->exit_actions[from](id, from, e->action_context);
+    if (e->transition_action)
+        e->transition_action(id, from, to, row, e->action_context);
+    if (changed && e->entry_actions && (size_t)to < state_count && e->entry_actions[to])
+        e->entry_actions[to](id, to, e->action_context);
+
+    // the timers only care when the state that owns the timeout is left or entered
+    if (changed && e->timeouts && timeout_owner(e, from) != timeout_owner(e, to))
+        start_timer(e, id, to);
+}
+
+// Move an instance; one branch decides whether anything else has to happen
+static inline void move_instance(StateEngine *e, uint32_t id, State to, uint32_t row)
+{
+    State from = e->states[id];
+    e->states[id] = to;
+    if (__builtin_expect(e->observed | atomic_load_explicit(&state_trace_on, memory_order_relaxed), 0))
+        transition_hooks(e, id, from, to, row);
+}
+
+/*
+ * state_engine_set_timeouts - add timed transitions
+ * @timed, @count: at most one timed transition per state (the first one wins)
+ *
+ * Returns: 1 on success, 0 on failure
+ * A state without its own timed transition inherits the one of its nearest
+ * parent. The timers of all instances are started for their current state.
+ */
+int state_engine_set_timeouts(StateEngine *e, const TimedTransition *timed, size_t count)
+{
+    if (!e || (!timed && count > 0)) return 0;
+
+    size_t state_count = e->index.state_count;
+    uint32_t *timeouts = calloc(state_count ? state_count : 1, sizeof(uint32_t));
+    State *targets = calloc(state_count ? state_count : 1, sizeof(State));
+    int *owners = malloc((state_count ? state_count : 1) * sizeof(int));
+    if (!timeouts || !targets || !owners) {
+        free(timeouts);
+        free(targets);
+        free(owners);
+        return 0;
+    }
+    for (size_t s = 0; s < state_count; s++) owners[s] = -1;
+
+    // 1) own timed transitions
+    uint32_t max_timeout = 1;
+    for (size_t i = 0; i < count; i++) {
+        size_t s = timed[i].from;
+        if (s >= state_count || timed[i].timeout == 0) {
+            free(timeouts);
+            free(targets);
+            free(owners);
+            return 0;
+        }
+        if (timeouts[s]) continue;
+        timeouts[s] = timed[i].timeout;
+        targets[s] = timed[i].to;
+        owners[s] = (int)s;
+        if (timed[i].timeout > max_timeout) max_timeout = timed[i].timeout;
+    }
+
+    // 2) inherited ones (the parent chains were validated when the index was built)
+    if (e->parents) {
+        for (size_t s = 0; s < state_count; s++) {
+            if (timeouts[s]) continue;
+            for (int a = e->parents[s]; a >= 0; a = e->parents[a]) {
+                if (owners[a] == a) {
+                    timeouts[s] = timeouts[a];
+                    targets[s] = targets[a];
+                    owners[s] = a;
+                    break;
+                }
+            }
+        }
+    }
+
+    // 3) a wheel long enough for the longest timeout
+    timer_wheel_free(&e->timers);
+    if (!timer_wheel_init(&e->timers, e->instance_count, max_timeout)) {
+        free(timeouts);
+        free(targets);
+        free(owners);
+        return 0;
+    }
+
+    free(e->timeouts);
+    free(e->timeout_targets);
+    free(e->timeout_owners);
+    e->timeouts = timeouts;
+    e->timeout_targets = targets;
+    e->timeout_owners = owners;
+    e->observed = 1;
+
+    for (size_t i = 0; i < e->instance_count; i++)
+        start_timer(e, (uint32_t)i, e->states[i]);
+    return 1;
+}
+
+// Timer callback: take the timed transition of the instance's state
+static void timer_expired(uint32_t id, void *context)
+{
+    StateEngine *e = context;
+    State from = e->states[id];
+    State to = e->timeout_targets[from];
+
+    e->states[id] = to;
+    transition_hooks(e, id, from, to, STATE_TRACE_TIMEOUT);
+
+    // the owner of the timeout was left (even if the target is inside it
+    // again, or is the same state), so the timer of the target starts anew;
+    // the new expiry goes into the next delta even when the state stayed
+    start_timer(e, id, to);
+    state_engine_mark_dirty(e, id);
+}
+
+/*
+ * state_engine_tick - advance the time by one tick
+ * Returns: number of instances that took a timed transition
+ * Only the instances whose timer expires in this tick are touched.
+ */
+size_t state_engine_tick(StateEngine *e)
+{
+    if (!e || !e->timeouts) return 0;
+
+    return timer_wheel_tick(&e->timers, timer_expired, e);
+}
+
+/*
+ * state_engine_set_actions - attach entry, exit and transition actions
+ * @entry, @exit: one action per state (NULL entries = none), or NULL
+ * @transition: called for every transition, NULL = none
+ * @context: passed to all actions
+ *
+ * Returns: 1 on success, 0 on failure
+ * The arrays are copied. Actions run on the thread that steps (or ticks) the
+ * engine, right after the instance's state has been updated.
+ */
+int state_engine_set_actions(StateEngine *e, const StateAction *entry, const StateAction *exit,
+                             TransitionAction transition, void *context)
+{
+    if (!e) return 0;
+
+    size_t state_count = e->index.state_count;
+    size_t size = (state_count ? state_count : 1) * sizeof(StateAction);
+    StateAction *entry_copy = entry ? malloc(size) : NULL;
+    StateAction *exit_copy = exit ? malloc(size) : NULL;
+    if ((entry && !entry_copy) || (exit && !exit_copy)) {
+        free(entry_copy);
+        free(exit_copy);
+        return 0;
+    }
+    if (entry) memcpy(entry_copy, entry, state_count * sizeof(StateAction));
+    if (exit) memcpy(exit_copy, exit, state_count * sizeof(StateAction));
+
+    free(e->entry_actions);
+    free(e->exit_actions);
+    e->entry_actions = entry_copy;
+    e->exit_actions = exit_copy;
+    e->transition_action = transition;
+    e->action_context = context;
+    e->observed = e->timeouts || e->dirty || entry_copy || exit_copy || transition;
+    return 1;
+}
+
+/*
+ * state_engine_track_changes - remember which instances change (for delta snapshots)
+ * Returns: 1 on success, 0 on failure
+ * All instances start as changed, so the first snapshot covers everybody.
+ */
+int state_engine_track_changes(StateEngine *e)
+{
+    if (!e) return 0;
+    if (e->dirty) return 1;
+
+    size_t words = (e->instance_count + 63) / 64;
+    e->dirty = malloc((words ? words : 1) * sizeof(uint64_t));
+    if (!e->dirty) return 0;
+
+    memset(e->dirty, 0xFF, (words ? words : 1) * sizeof(uint64_t));
+    if (e->instance_count & 63)
+        e->dirty[words - 1] = (1ull << (e->instance_count & 63)) - 1;
+    e->observed = 1;
+    return 1;
+}
+
+/*
+ * state_engine_set_batch_guard - use batch instead of calling guard once per instance
+ * Returns: number of transitions that use guard (0 if there are none)
+ */
+int state_engine_set_batch_guard(StateEngine *e, bool (*guard)(void), BatchGuard batch, void *context)
+{
+    if (!e || !guard) return 0;
+
+    int replaced = 0;
+    size_t compiled = e->index.offsets[e->index.state_count];
+    for (size_t i = 0; i < compiled; i++) {
+        if (e->index.transitions[i].guard == guard) {
+            e->batch_guards[i] = batch;
+            e->batch_contexts[i] = context;
+            replaced++;
+        }
+    }
+    return replaced;
+}
+
+/*
+ * group_by_state - counting sort of the instance ids by current state
+ * Instances in a state outside the table keep their state and are skipped
+ */
+static void group_by_state(StateEngine *e)
+{
+    size_t state_count = e->index.state_count;
+    uint32_t *offsets = e->group_offsets;
+
+    memset(offsets, 0, (state_count + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < e->instance_count; i++) {
+        if ((size_t)e->states[i] < state_count)
+            offsets[e->states[i] + 1]++;
+    }
+
+    for (size_t s = 0; s < state_count; s++)
+        offsets[s + 1] += offsets[s];
+
+    // offsets[s] is used as the insert position and ends up at the start of group s+1;
+    // we shift it back afterwards
+    for (size_t i = 0; i < e->instance_count; i++) {
+        if ((size_t)e->states[i] < state_count)
+            e->order[offsets[e->states[i]]++] = (uint32_t)i;
+    }
+    for (size_t s = state_count; s > 0; s--)
+        offsets[s] = offsets[s - 1];
+    offsets[0] = 0;
+}
+
+/*
+ * step_group - run the transitions of one state for the instances in it
+ * @pending, @count: ids of the instances still looking for a transition
+ * @moved: if not NULL, the ids of the instances that move are appended at *moved
+ *
+ * Returns: number of instances that stay; their ids are left at the start of pending
+ */
+static size_t step_group(StateEngine *e, size_t state, uint32_t *pending, size_t count, uint32_t **moved)
+{
+    uint32_t first = e->index.offsets[state];
+    uint32_t last = e->index.offsets[state + 1];
+
+    for (uint32_t t = first; t < last && count > 0; t++) {
+        const CompiledTransition *tr = &e->index.transitions[t];
+
+        // unconditional transition - everybody left takes it
+        if (tr->guard == NULL) {
+            for (size_t i = 0; i < count; i++)
+                move_instance(e, pending[i], tr->to, tr->row);
+            if (moved) {
+                memcpy(*moved, pending, count * sizeof(uint32_t));
+                *moved += count;
+            }
+            return 0;
+        }
+
+        // evaluate the guard for the whole group
+        if (e->batch_guards[t]) {
+            e->batch_guards[t](pending, count, e->results, e->batch_contexts[t]);
+        } else {
+            for (size_t i = 0; i < count; i++)
+                e->results[i] = tr->guard();
+        }
+
+        // instances with a true guard move, the others stay pending for the next transition
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (e->results[i]) {
+                move_instance(e, pending[i], tr->to, tr->row);
+                if (moved) *(*moved)++ = pending[i];
+            } else {
+                pending[kept++] = pending[i];
+            }
+        }
+        count = kept;
+    }
+    // instances left in pending had no matching transition and stay where they are
+    return count;
+}
+
+/*
+ * state_engine_step - one step of every instance
+ * All groups are formed before any instance moves, so an instance never
+ * makes two transitions in one step.
+ */
+void state_engine_step(StateEngine *e)
+{
+    if (!e || e->instance_count == 0) return;
+
+    group_by_state(e);
+
+    for (size_t s = 0; s < e->index.state_count; s++) {
+        uint32_t start = e->group_offsets[s];
+        uint32_t end = e->group_offsets[s + 1];
+        if (end > start)
+            step_group(e, s, e->order + start, end - start, NULL);
+    }
+}
+
+/*
+ * regroup_moved - grouping for the next step from the previous one
+ * @moved, @moved_count: instances that changed state in the last step
+ * The instances that stayed are still at the start of their old group
+ * (e->stayed[s] of them), so only the moved instances are sorted again.
+ */
+static void regroup_moved(StateEngine *e, const uint32_t *moved, size_t moved_count)
+{
+    size_t state_count = e->index.state_count;
+    uint32_t *offsets = e->next_offsets;
+
+    // offsets[s + 1] = instances arriving in s, then turned into the group starts
+    memset(offsets, 0, (state_count + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < moved_count; i++)
+        offsets[e->states[moved[i]] + 1]++;
+
+    uint32_t start = 0;
+    for (size_t s = 0; s < state_count; s++) {
+        uint32_t size = e->stayed[s] + offsets[s + 1];
+        offsets[s] = start;
+        start += size;
+    }
+    offsets[state_count] = start;
+
+    // the old group starts are not needed any more and become the insert positions
+    for (size_t s = 0; s < state_count; s++) {
+        memcpy(e->next_order + offsets[s], e->order + e->group_offsets[s], e->stayed[s] * sizeof(uint32_t));
+        e->group_offsets[s] = offsets[s] + e->stayed[s];
+    }
+    for (size_t i = 0; i < moved_count; i++)
+        e->next_order[e->group_offsets[e->states[moved[i]]]++] = moved[i];
+
+    uint32_t *order = e->order;
+    e->order = e->next_order;
+    e->next_order = order;
+    e->next_offsets = e->group_offsets;
+    e->group_offsets = offsets;
+}
+
+/*
+ * state_engine_run - steps steps of every instance
+ * Same result as calling state_engine_step steps times, but the grouping by
+ * state is carried from one step to the next: only the instances that moved
+ * are sorted again, so a guard may see the instances of a group in a
+ * different order. Nothing but the steps may change e->states during a run.
+ */
+void state_engine_run(StateEngine *e, size_t steps)
+{
+    if (!e || e->instance_count == 0 || steps == 0) return;
+
+    size_t state_count = e->index.state_count;
+    if (steps > 1 && !e->next_order) {
+        e->next_order = malloc(e->instance_count * sizeof(uint32_t));
+        e->next_offsets = malloc((state_count + 1) * sizeof(uint32_t));
+        e->moved = malloc(e->instance_count * sizeof(uint32_t));
+        e->stayed = malloc((state_count ? state_count : 1) * sizeof(uint32_t));
+        if (!e->next_order || !e->next_offsets || !e->moved || !e->stayed) {
+            free(e->next_order);
+            free(e->next_offsets);
+            free(e->moved);
+            free(e->stayed);
+            e->next_order = e->next_offsets = e->moved = e->stayed = NULL;
+        }
+    }
+    // without the scratch arrays every step sorts all instances
+    if (steps == 1 || !e->next_order) {
+        for (size_t n = 0; n < steps; n++)
+            state_engine_step(e);
+        return;
+    }
+
+    group_by_state(e);
+    for (size_t n = 0; n < steps; n++) {
+        uint32_t *moved = e->moved;
+        for (size_t s = 0; s < state_count; s++) {
+            uint32_t start = e->group_offsets[s];
+            uint32_t end = e->group_offsets[s + 1];
+            e->stayed[s] = end > start ? (uint32_t)step_group(e, s, e->order + start, end - start, &moved) : 0;
+        }
+        if (n + 1 < steps)
+            regroup_moved(e, e->moved, (size_t)(moved - e->moved));
+    }
+}
+// Release the engine
+void state_engine_free(StateEngine *e)
+{
+    if (!e) return;
+
+    if (!e->shared_index) transition_index_free(&e->index);
+    free(e->batch_guards);
+    free(e->batch_contexts);
+    free(e->states);
+    free(e->order);
+    free(e->group_offsets);
+    free(e->results);
+    free(e->next_order);
+    free(e->next_offsets);
+    free(e->moved);
+    free(e->stayed);
+    free(e->parents);
+    free(e->timeouts);
+    free(e->timeout_targets);
+    free(e->timeout_owners);
+    free(e->entry_actions);
+    free(e->exit_actions);
+    free(e->dirty);
+    timer_wheel_free(&e->timers);
+    memset(e, 0, sizeof(*e));
+}
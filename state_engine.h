@@ -0,0 +1,119 @@
+/*
+ * state_engine.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Batched engine for many instances of the table-driven state machine.
+ * All instances live in one contiguous state array and one call steps all of
+ * them. Inside a step the instances are grouped by their current state, so
+ * the transitions of a state are evaluated for the whole group at once, and a
+ * guard can be given a batch version that decides for the whole group in
+ * one call.
+ * States can be nested (a child inherits the transitions of its parents) and
+ * can have timed transitions, which are driven by a timer wheel: one
+ * state_engine_tick() costs O(1) plus the work for the timers that expire,
+ * however many instances are waiting.
+ * Entry, exit and transition actions can be attached, and every transition
+ * is recorded by state_trace() when tracing is on. Without actions, timers
+ * and tracing, a transition costs one extra (never taken) branch.
+ */
+
+#ifndef STATE_ENGINE_H
+#define STATE_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "transition_table.h"
+#include "transition_index.h"
+#include "timer_wheel.h"
+#include "state_trace.h"
+
+/* Batch version of a guard
+   - instances: ids of the instances the guard is evaluated for
+   - count: number of ids
+   - results: one result per id, true = take the transition
+   - context: pointer given in state_engine_set_batch_guard
+*/
+typedef void (*BatchGuard)(const uint32_t *instances, size_t count, bool *results, void *context);
+
+/* Actions
+   - instance: id of the instance in this engine
+   - state: the state that is entered or left
+   - transition: row in the transition table, or STATE_TRACE_TIMEOUT for timed transitions
+   Exit and entry actions only run when the state changes; the order is
+   exit(from), transition(from, to), entry(to). */
+typedef void (*StateAction)(uint32_t instance, State state, void *context);
+typedef void (*TransitionAction)(uint32_t instance, State from, State to, uint32_t transition, void *context);
+
+typedef struct {
+    TransitionIndex index;          // transitions grouped by 'from' state
+    int             shared_index;   // 1 = the index belongs to somebody else (not freed)
+    BatchGuard     *batch_guards;   // per compiled transition, NULL = call the guard per instance
+    void          **batch_contexts; // context for every batch guard
+    size_t          instance_count;
+    State          *states;         // current state of every instance
+    uint32_t       *order;          // scratch: instance ids grouped by state
+    uint32_t       *group_offsets;  // scratch: start of every state's group in order
+    bool           *results;        // scratch: guard results for one group
+    uint32_t       *next_order;     // scratch of state_engine_run: grouping for the next step, NULL = not allocated yet
+    uint32_t       *next_offsets;   // scratch of state_engine_run: start of every group in next_order
+    uint32_t       *moved;          // scratch of state_engine_run: instances that changed state in a step
+    uint32_t       *stayed;         // scratch of state_engine_run: per state, instances that did not move
+    int            *parents;        // parent of every state (-1 = none), NULL = flat machine
+    uint32_t       *timeouts;       // per state: timeout in ticks, 0 = none; NULL = no timers
+    State          *timeout_targets;// per state: where the timed transition goes
+    int            *timeout_owners; // per state: state that owns its timeout (itself or a parent), -1 = none
+    TimerWheel      timers;         // one timer per instance
+    StateAction    *entry_actions;  // per state, NULL = none
+    StateAction    *exit_actions;   // per state, NULL = none
+    TransitionAction transition_action;
+    void           *action_context;
+    int             observed;       // timers, actions or change tracking: transitions take the slow path
+    uint32_t        instance_base;  // added to the instance ids in the trace (shards)
+    uint64_t       *dirty;          // bit per instance changed since the last snapshot, NULL = not tracked
+    uint64_t        snapshot_sequence; // number of the last snapshot taken or restored
+} StateEngine;
+
+int state_engine_init(StateEngine *e, const Transition *table, size_t count, size_t state_count,
+                      size_t instance_count, State initial_state);
+int state_engine_init_nested(StateEngine *e, const Transition *table, size_t count,
+                             const int *parents, size_t state_count,
+                             size_t instance_count, State initial_state);
+int state_engine_init_shared(StateEngine *e, const TransitionIndex *index, const int *parents,
+                             size_t instance_count, State initial_state);
+int state_engine_set_timeouts(StateEngine *e, const TimedTransition *timed, size_t count);
+size_t state_engine_tick(StateEngine *e);
+int state_engine_set_actions(StateEngine *e, const StateAction *entry, const StateAction *exit,
+                             TransitionAction transition, void *context);
+int state_engine_track_changes(StateEngine *e);
+int state_engine_set_batch_guard(StateEngine *e, bool (*guard)(void), BatchGuard batch, void *context);
+void state_engine_step(StateEngine *e);
+void state_engine_run(StateEngine *e, size_t steps);
+void state_engine_free(StateEngine *e);
+
+// Mark an instance as changed, e.g. after its per-instance data was modified
+static inline void state_engine_mark_dirty(StateEngine *e, uint32_t id)
+{
+    if (e->dirty && id < e->instance_count)
+        e->dirty[id >> 6] |= 1ull << (id & 63);
+}
+
+#endif
@@ -23,8 +23,24 @@
  *
  * Simple state machine example - header file
  */
+#include <stdbool.h>
+#include "transition_table.h"
+
 bool user_pressed_exit(void);
 bool start_moving(void);
 bool stop_moving(void);
 bool shutdown(void);
-bool user_pressed_exit_nonblocking(void);
\ No newline at end of file
+bool user_pressed_exit_nonblocking(void);
+
+/* The state diagram of the demo machine, defined once:
+   [*] -> Init -> Still -> Moving -> Still
+                           \-> Stop -> [*]
+   We keep order so that shutdown (Moving -> Stop) is checked before stop_moving.
+   T(from, guard, to) as described in transition_table.h */
+#define DEMO_TRANSITIONS(T)                      \
+    /* from state, guard function, to state */   \
+    T(INIT,   NULL,         STILL)               \
+    T(STILL,  start_moving, MOVING)              \
+    T(MOVING, shutdown,     STOP)                \
+    T(MOVING, stop_moving,  STILL)               \
+    T(STOP,   NULL,         STOP)
@@ -0,0 +1,301 @@
+/*
+ * state_snapshot.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Full and delta snapshots of StateEngine instances, restored through mmap.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "state_snapshot.h"
+
+// Append the record of instance id to out, returns the position after it
+static unsigned char *encode_record(unsigned char *out, const StateEngine *e, uint32_t id,
+                                    const unsigned char *data, size_t data_size)
+{
+    SnapshotRecord r;
+    r.instance = id;
+    r.state = (uint32_t)e->states[id];
+    r.timer = e->timeouts ? timer_wheel_remaining(&e->timers, id) : 0;
+    r.data_len = (uint32_t)data_size;
+
+    memcpy(out, &r, sizeof(r));
+    out += sizeof(r);
+    if (data_size) {
+        memcpy(out, data + (size_t)id * data_size, data_size);
+        out += data_size;
+    }
+    return out;
+}
+
+/*
+ * state_snapshot_capture - copy the instances into a snapshot (in memory)
+ * @s: snapshot to fill, release with state_snapshot_free
+ * @e: engine; for STATE_SNAPSHOT_DELTA it must track changes
+ * @data: per-instance data, data_size bytes per instance (NULL = none)
+ * @kind: STATE_SNAPSHOT_FULL (every instance) or STATE_SNAPSHOT_DELTA (changed ones)
+ *
+ * Returns: 1 on success, 0 on failure
+ * The cost is one record copy per captured instance; afterwards the changes
+ * start again from zero, so the next delta is relative to this snapshot.
+ */
+int state_snapshot_capture(StateSnapshot *s, StateEngine *e, const void *data, size_t data_size, int kind)
+{
+    if (!s || !e || (kind != STATE_SNAPSHOT_FULL && kind != STATE_SNAPSHOT_DELTA)) return 0;
+    if (kind == STATE_SNAPSHOT_DELTA && !e->dirty) return 0;
+    if (!data) data_size = 0;
+    if (data_size > UINT32_MAX) return 0;
+    memset(s, 0, sizeof(*s));
+
+    size_t words = (e->instance_count + 63) / 64;
+    size_t count = e->instance_count;
+    if (kind == STATE_SNAPSHOT_DELTA) {
+        count = 0;
+        for (size_t w = 0; w < words; w++)
+            count += (size_t)__builtin_popcountll(e->dirty[w]);
+    }
+
+    size_t record_size = sizeof(SnapshotRecord) + data_size;
+    if (count > SIZE_MAX / record_size) return 0;
+    s->size = count * record_size;
+    s->records = malloc(s->size ? s->size : 1);
+    if (!s->records) return 0;
+
+    unsigned char *out = s->records;
+    if (kind == STATE_SNAPSHOT_FULL) {
+        for (size_t i = 0; i < e->instance_count; i++)
+            out = encode_record(out, e, (uint32_t)i, data, data_size);
+    } else {
+        // only the set bits: one word test per 64 unchanged instances
+        for (size_t w = 0; w < words; w++) {
+            for (uint64_t bits = e->dirty[w]; bits; bits &= bits - 1) {
+                uint32_t id = (uint32_t)(w * 64 + (size_t)__builtin_ctzll(bits));
+                out = encode_record(out, e, id, data, data_size);
+            }
+        }
+    }
+
+    if (e->dirty) memset(e->dirty, 0, (words ? words : 1) * sizeof(uint64_t));
+
+    s->header.magic = STATE_SNAPSHOT_MAGIC;
+    s->header.version = STATE_SNAPSHOT_VERSION;
+    s->header.kind = (uint16_t)kind;
+    s->header.sequence = ++e->snapshot_sequence;
+    s->header.instance_count = e->instance_count;
+    s->header.record_count = count;
+    s->header.data_size = (uint32_t)data_size;
+    s->header.now = e->timers.now;
+    return 1;
+}
+
+/*
+ * state_snapshot_write - write a captured snapshot to a file
+ * Returns: 1 on success, 0 on failure
+ * Only reads s, so it can run on another thread while the engine steps.
+ */
+int state_snapshot_write(const StateSnapshot *s, const char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        return 0;
+    }
+
+    int ok = fwrite(&s->header, sizeof(s->header), 1, file) == 1 &&
+             (s->size == 0 || fwrite(s->records, 1, s->size, file) == s->size);
+    if (fclose(file) != 0) ok = 0;
+    return ok;
+}
+
+/*
+ * state_snapshot_merge - bring a full snapshot forward by the next delta
+ * @full: full snapshot (as captured: one record per instance, in instance order)
+ * @delta: the delta captured right after it (sequence one higher)
+ *
+ * Returns: 1 on success, 0 on failure (full is unchanged then)
+ * Afterwards full is the full snapshot of the moment the delta was captured,
+ * so a fleet only needs one full capture: later full snapshots are a delta
+ * capture on the thread that steps, and the merge and the write on another.
+ * Only full is written, so it must not be written at the same time.
+ */
+int state_snapshot_merge(StateSnapshot *full, const StateSnapshot *delta)
+{
+    if (!full || !delta || full->header.kind != STATE_SNAPSHOT_FULL ||
+        delta->header.kind != STATE_SNAPSHOT_DELTA ||
+        delta->header.sequence != full->header.sequence + 1 ||
+        delta->header.instance_count != full->header.instance_count ||
+        delta->header.data_size != full->header.data_size ||
+        delta->header.now < full->header.now) return 0;
+
+    size_t record_size = sizeof(SnapshotRecord) + full->header.data_size;
+    if (full->header.record_count != full->header.instance_count ||
+        full->size != full->header.record_count * record_size ||
+        delta->size != delta->header.record_count * record_size) return 0;
+    for (uint64_t n = 0; n < delta->header.record_count; n++) {
+        SnapshotRecord r;
+        memcpy(&r, delta->records + n * record_size, sizeof(r));
+        if (r.instance >= full->header.record_count) return 0;
+    }
+
+    // the timers count from the capture time, which moved on; an instance whose
+    // timer expired in between took the timed transition and is in the delta
+    uint64_t elapsed = delta->header.now - full->header.now;
+    if (elapsed > 0) {
+        for (uint64_t n = 0; n < full->header.record_count; n++) {
+            unsigned char *p = full->records + n * record_size + offsetof(SnapshotRecord, timer);
+            uint32_t timer;
+            memcpy(&timer, p, sizeof(timer));
+            if (timer == 0) continue;
+            timer = timer > elapsed ? timer - (uint32_t)elapsed : 0;
+            memcpy(p, &timer, sizeof(timer));
+        }
+    }
+
+    for (uint64_t n = 0; n < delta->header.record_count; n++) {
+        const unsigned char *record = delta->records + n * record_size;
+        SnapshotRecord r;
+        memcpy(&r, record, sizeof(r));
+        memcpy(full->records + (size_t)r.instance * record_size, record, record_size);
+    }
+
+    full->header.sequence = delta->header.sequence;
+    full->header.now = delta->header.now;
+    return 1;
+}
+
+// Release a captured snapshot
+void state_snapshot_free(StateSnapshot *s)
+{
+    if (!s) return;
+    free(s->records);
+    s->records = NULL;
+    s->size = 0;
+}
+
+/*
+ * check_records - validate every record before anything is changed
+ * Returns: 1 if the whole file can be applied to e
+ */
+static int check_records(const StateEngine *e, const SnapshotHeader *h,
+                         const unsigned char *p, const unsigned char *end)
+{
+    for (uint64_t n = 0; n < h->record_count; n++) {
+        SnapshotRecord r;
+        if ((size_t)(end - p) < sizeof(r)) return 0;
+        memcpy(&r, p, sizeof(r));
+        p += sizeof(r);
+
+        if (r.instance >= e->instance_count || r.state >= e->index.state_count) return 0;
+        if (r.timer && (!e->timeouts || r.timer > e->timers.max_timeout)) return 0;
+        if (r.data_len != h->data_size || (size_t)(end - p) < r.data_len) return 0;
+        p += r.data_len;
+    }
+    return 1;
+}
+
+/*
+ * state_snapshot_restore - apply a full snapshot or the next delta to e
+ * @e: engine with the same instance count, table and timed transitions
+ * @data: per-instance data to restore (NULL = skip the data)
+ * @data_size: bytes per instance, must match the file when data is given
+ * @filename: snapshot file, mapped read-only
+ *
+ * Returns: 1 on success, 0 on failure (e is unchanged then)
+ * Restore the full snapshot first and then its deltas in order - a delta
+ * that does not follow the last applied snapshot is refused.
+ */
+int state_snapshot_restore(StateEngine *e, void *data, size_t data_size, const char *filename)
+{
+    if (!e) return 0;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open file");
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        close(fd);
+        return 0;
+    }
+
+    size_t size = (size_t)st.st_size;
+    const unsigned char *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return 0;
+    }
+
+    SnapshotHeader h;
+    memcpy(&h, map, sizeof(h));
+    const unsigned char *p = map + sizeof(h);
+    const unsigned char *end = map + size;
+
+    int ok = h.magic == STATE_SNAPSHOT_MAGIC && h.version == STATE_SNAPSHOT_VERSION &&
+             h.instance_count == e->instance_count &&
+             (h.kind == STATE_SNAPSHOT_FULL ||
+              (h.kind == STATE_SNAPSHOT_DELTA && h.sequence == e->snapshot_sequence + 1)) &&
+             (!data || h.data_size == data_size) &&
+             check_records(e, &h, p, end);
+
+    if (ok) {
+        madvise((void *)map, size, MADV_SEQUENTIAL);
+
+        // the timers of the records count from the capture time; instances not in
+        // a delta keep their expiry tick from the earlier snapshot, still in the future
+        if (e->timeouts)
+            timer_wheel_set_time(&e->timers, h.now);
+
+        for (uint64_t n = 0; n < h.record_count; n++) {
+            SnapshotRecord r;
+            memcpy(&r, p, sizeof(r));
+            p += sizeof(r);
+
+            e->states[r.instance] = (State)r.state;
+            if (r.timer)
+                timer_wheel_schedule(&e->timers, r.instance, r.timer);
+            else if (e->timeouts)
+                timer_wheel_cancel(&e->timers, r.instance);
+            if (data && r.data_len)
+                memcpy((unsigned char *)data + (size_t)r.instance * data_size, p, r.data_len);
+            p += r.data_len;
+        }
+
+        // the engine now matches the snapshot chain up to this file
+        e->snapshot_sequence = h.sequence;
+        if (e->dirty) {
+            size_t words = (e->instance_count + 63) / 64;
+            memset(e->dirty, 0, (words ? words : 1) * sizeof(uint64_t));
+        }
+    }
+
+    munmap((void *)map, size);
+    return ok;
+}
@@ -0,0 +1,86 @@
+/*
+ * state_snapshot.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Snapshots of a StateEngine fleet, so a restarted process continues where
+ * the old one stopped instead of replaying its inputs.
+ * A snapshot file has a SnapshotHeader followed by one record per instance,
+ * in the same length-prefixed style as the Person files:
+ *   uint32 instance, uint32 state, uint32 timer (ticks left, 0 = none),
+ *   uint32 data_len, then data_len bytes of per-instance data
+ * A full snapshot has every instance, a delta only those that changed since
+ * the previous snapshot (state_engine_track_changes keeps a dirty bitmap).
+ * Capturing copies the records into memory on the thread that steps the
+ * engine: a delta only the changed ones, a full snapshot every instance.
+ * Writing the file can then happen on another thread while the engine keeps
+ * stepping. Only the first full snapshot needs the pass over every instance:
+ * the writing thread keeps that full snapshot and brings it forward with each
+ * delta (state_snapshot_merge), so a later full snapshot costs the stepping
+ * thread no more than a delta.
+ */
+
+#ifndef STATE_SNAPSHOT_H
+#define STATE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "state_engine.h"
+
+#define STATE_SNAPSHOT_MAGIC   0x50414E53u      // "SNAP" in a little-endian file
+#define STATE_SNAPSHOT_VERSION 1
+
+#define STATE_SNAPSHOT_FULL  0
+#define STATE_SNAPSHOT_DELTA 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t kind;              // STATE_SNAPSHOT_FULL or STATE_SNAPSHOT_DELTA
+    uint64_t sequence;          // full snapshots start a chain, every delta adds 1
+    uint64_t instance_count;    // instances in the engine
+    uint64_t record_count;      // records in this file
+    uint64_t now;               // timer wheel time of the capture, the timers count from here
+    uint32_t data_size;         // bytes of per-instance data in every record
+    uint32_t reserved;
+} SnapshotHeader;
+
+typedef struct {
+    uint32_t instance;
+    uint32_t state;
+    uint32_t timer;             // ticks from 'now' to the timed transition, 0 = none
+    uint32_t data_len;          // followed by data_len bytes
+} SnapshotRecord;
+
+/* A captured snapshot, in file layout, waiting to be written */
+typedef struct {
+    SnapshotHeader header;
+    unsigned char *records;
+    size_t         size;        // bytes in records
+} StateSnapshot;
+
+int state_snapshot_capture(StateSnapshot *s, StateEngine *e, const void *data, size_t data_size, int kind);
+int state_snapshot_merge(StateSnapshot *full, const StateSnapshot *delta);
+int state_snapshot_write(const StateSnapshot *s, const char *filename);
+void state_snapshot_free(StateSnapshot *s);
+int state_snapshot_restore(StateEngine *e, void *data, size_t data_size, const char *filename);
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ * state_trace.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Per-thread trace ring buffers for state machine transitions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "state_trace.h"
+
+typedef struct TraceRing {
+    TraceRecord      *records;
+    atomic_uint_fast64_t head;      // records written so far (only the owner thread writes)
+    uint32_t          thread;
+    struct TraceRing *next;
+} TraceRing;
+
+atomic_int state_trace_on = 0;
+
+// all rings, so the dump can find them; the lock is only taken when a thread starts tracing
+static pthread_mutex_t rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static TraceRing *rings = NULL;
+static uint32_t ring_count = 0;
+
+// incremented by state_trace_free, so threads notice that their ring is gone
+static atomic_uint ring_generation = 0;
+
+// this thread's ring
+static _Thread_local TraceRing *local_ring = NULL;
+static _Thread_local unsigned local_generation = 0;
+
+// Turn tracing on (1) or off (0)
+void state_trace_enable(int on)
+{
+    atomic_store_explicit(&state_trace_on, on ? 1 : 0, memory_order_relaxed);
+}
+
+// Create and register the ring of the calling thread, returns NULL on failure
+static TraceRing *ring_for_thread(void)
+{
+    TraceRing *ring = malloc(sizeof(TraceRing));
+    if (!ring) return NULL;
+
+    ring->records = calloc(STATE_TRACE_RING_SIZE, sizeof(TraceRecord));
+    if (!ring->records) {
+        free(ring);
+        return NULL;
+    }
+    atomic_init(&ring->head, 0);
+
+    pthread_mutex_lock(&rings_lock);
+    ring->thread = ring_count++;
+    ring->next = rings;
+    rings = ring;
+    pthread_mutex_unlock(&rings_lock);
+
+    local_ring = ring;
+    local_generation = atomic_load_explicit(&ring_generation, memory_order_relaxed);
+    return ring;
+}
+
+/*
+ * state_trace_record - append one transition to the calling thread's ring
+ * Called through state_trace(), only when tracing is on
+ */
+void state_trace_record(uint32_t instance, State from, State to, uint32_t transition)
+{
+    TraceRing *ring = local_ring;
+    if (!ring || local_generation != atomic_load_explicit(&ring_generation, memory_order_relaxed))
+        ring = ring_for_thread();
+    if (!ring) return;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    TraceRecord *r = &ring->records[head & (STATE_TRACE_RING_SIZE - 1)];
+    r->timestamp_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    r->instance = instance;
+    r->transition = transition;
+    r->from = (uint16_t)from;
+    r->to = (uint16_t)to;
+    r->reserved = 0;
+
+    // publish the record (release: the fields above are visible before the new head)
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+/*
+ * dump_ring - copy the records of a ring that may still be written to
+ * Records that the owner overwrote (or may be overwriting) while we copied
+ * are dropped.
+ * Returns: number of records copied to out (oldest first)
+ */
+static uint32_t dump_ring(TraceRing *ring, TraceRecord *out)
+{
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t first = head > STATE_TRACE_RING_SIZE ? head - STATE_TRACE_RING_SIZE : 0;
+
+    for (uint64_t i = first; i < head; i++)
+        out[i - first] = ring->records[i & (STATE_TRACE_RING_SIZE - 1)];
+
+    // the copies above must be done before head is read again (seqlock read)
+    atomic_thread_fence(memory_order_acquire);
+
+    // the owner may have lapped the start of our copy in the meantime, and may
+    // be writing record after right now - its slot is the one of after - SIZE
+    uint64_t after = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t valid = after + 1 > STATE_TRACE_RING_SIZE ? after + 1 - STATE_TRACE_RING_SIZE : 0;
+    if (valid <= first) return (uint32_t)(head - first);
+    if (valid >= head) return 0;
+
+    uint64_t skip = valid - first;
+    memmove(out, out + skip, (head - valid) * sizeof(TraceRecord));
+    return (uint32_t)(head - valid);
+}
+
+/*
+ * state_trace_dump - write all rings to a binary file
+ * @filename: output file, read it with trace_decode
+ *
+ * Returns: 1 on success, 0 on failure
+ * Threads may keep tracing while the dump is written.
+ */
+int state_trace_dump(const char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        perror("Failed to open file");
+        return 0;
+    }
+
+    TraceRecord *copy = malloc(STATE_TRACE_RING_SIZE * sizeof(TraceRecord));
+    if (!copy) {
+        fclose(file);
+        return 0;
+    }
+
+    pthread_mutex_lock(&rings_lock);
+
+    TraceFileHeader header = { STATE_TRACE_MAGIC, STATE_TRACE_VERSION, sizeof(TraceRecord), ring_count, 0 };
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for (TraceRing *ring = rings; ring && ok; ring = ring->next) {
+        TraceRingHeader ring_header = { ring->thread, dump_ring(ring, copy) };
+        ok = fwrite(&ring_header, sizeof(ring_header), 1, file) == 1 &&
+             fwrite(copy, sizeof(TraceRecord), ring_header.count, file) == ring_header.count;
+    }
+
+    pthread_mutex_unlock(&rings_lock);
+
+    free(copy);
+    if (fclose(file) != 0) ok = 0;
+    return ok;
+}
+
+/*
+ * state_trace_free - turn tracing off and release all rings
+ * Only call it when no other thread is recording; threads that trace
+ * again later get a new ring
+ */
+void state_trace_free(void)
+{
+    state_trace_enable(0);
+
+    pthread_mutex_lock(&rings_lock);
+    while (rings) {
+        TraceRing *next = rings->next;
+        free(rings->records);
+        free(rings);
+        rings = next;
+    }
+    ring_count = 0;
+    atomic_fetch_add_explicit(&ring_generation, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&rings_lock);
+
+    local_ring = NULL;
+}
@@ -0,0 +1,87 @@
+/*
+ * state_trace.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Binary transition trace.
+ * Every thread that records transitions gets its own ring buffer, so
+ * recording is a few stores without locks or atomics read-modify-write; when
+ * the ring is full the oldest records are overwritten. state_trace_dump()
+ * writes all rings to a file that trace_decode turns into text.
+ * When tracing is off, state_trace() costs one predictable branch.
+ */
+
+#ifndef STATE_TRACE_H
+#define STATE_TRACE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "transition_table.h"
+
+#define STATE_TRACE_MAGIC     0x43525453u  // "STRC" in little-endian
+#define STATE_TRACE_VERSION   1
+#define STATE_TRACE_RING_SIZE 65536        // records per thread (power of two)
+
+// transition number used for timed transitions (they are not rows of the table)
+#define STATE_TRACE_TIMEOUT   UINT32_MAX
+
+/* One recorded transition (24 bytes, written to the dump as is) */
+typedef struct {
+    uint64_t timestamp_ns;      // CLOCK_MONOTONIC
+    uint32_t instance;          // machine instance
+    uint32_t transition;        // row in the transition table, or STATE_TRACE_TIMEOUT
+    uint16_t from;
+    uint16_t to;
+    uint32_t reserved;
+} TraceRecord;
+
+/* Dump file layout:
+   TraceFileHeader, then for every ring: TraceRingHeader + count records
+   (oldest first) */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;       // sizeof(TraceRecord)
+    uint32_t ring_count;
+    uint32_t reserved;
+} TraceFileHeader;
+
+typedef struct {
+    uint32_t thread;            // ring number, in the order the threads started tracing
+    uint32_t count;             // records that follow
+} TraceRingHeader;
+
+extern atomic_int state_trace_on;
+
+void state_trace_enable(int on);
+void state_trace_record(uint32_t instance, State from, State to, uint32_t transition);
+int state_trace_dump(const char *filename);
+void state_trace_free(void);
+
+/* Record a transition if tracing is on - the only cost when it is off is
+   this (relaxed, i.e. plain) load and a branch that is always predicted right */
+static inline void state_trace(uint32_t instance, State from, State to, uint32_t transition)
+{
+    if (__builtin_expect(atomic_load_explicit(&state_trace_on, memory_order_relaxed), 0))
+        state_trace_record(instance, from, to, transition);
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * states_events.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Event-driven version of the table-driven state machine.
+ * Instead of spinning in while (state != STATE_STOP) and polling the keyboard
+ * in every guard, the machine sleeps until an event arrives in its queue and
+ * only then evaluates the transition table. The guards just look at the event
+ * being processed.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "transition_table.h"
+#include "event_queue.h"
+#include "states_events.h"
+#include "input_reactor.h"
+
+/* The event being processed, the guards below look at it */
+static _Thread_local EventType current_event = EVENT_NONE;
+
+bool event_is_start(void)    { return current_event == EVENT_START; }
+bool event_is_stop(void)     { return current_event == EVENT_STOP; }
+bool event_is_shutdown(void) { return current_event == EVENT_SHUTDOWN; }
+
+/* The demo diagram (DEMO_TRANSITIONS in state_machine.h) plus Still -> Stop,
+   and every conditional transition waits for an event:
+   [*] -> Init -> Still -> Moving -> Still
+                   |         \-> Stop -> [*]
+                   \-> Stop
+   A shutdown (also sent at the end of the input) must stop a machine
+   that is not moving, otherwise it would wait for events forever. */
+static const Transition event_transitions[] = {
+    { STATE_INIT,   NULL,              STATE_STILL },
+    { STATE_STILL,  event_is_start,    STATE_MOVING },
+    { STATE_STILL,  event_is_shutdown, STATE_STOP },
+    { STATE_MOVING, event_is_shutdown, STATE_STOP },
+    { STATE_MOVING, event_is_stop,     STATE_STILL },
+};
+
+#define EVENT_TRANSITION_COUNT (sizeof(event_transitions) / sizeof(event_transitions[0]))
+
+/*
+ * event_machine_step - feed one event (or EVENT_NONE) to the table
+ * Returns: the next state
+ */
+State event_machine_step(const Transition *table, size_t count, State state, EventType event)
+{
+    current_event = event;
+    State next = transition_table_step(table, count, state);
+    current_event = EVENT_NONE;
+    return next;
+}
+
+/*
+ * event_machine_run - run a machine until it reaches STATE_STOP
+ * @table, @count: transition table whose guards use the event_is_* functions
+ * @q: event queue the machine consumes
+ * @stats: latency statistics (may be NULL)
+ *
+ * Returns: the final state
+ */
+State event_machine_run(const Transition *table, size_t count, EventQueue *q, EventStats *stats)
+{
+    State state = STATE_INIT;
+
+    while (state != STATE_STOP) {
+        // 1) take all unconditional transitions without waiting
+        State next = event_machine_step(table, count, state, EVENT_NONE);
+        if (next != state) {
+            state = next;
+            continue;
+        }
+
+        // 2) sleep until an event arrives (no CPU is used here)
+        Event event;
+        if (!event_queue_wait(q, &event, -1)) continue;
+
+        next = event_machine_step(table, count, state, event.type);
+
+        // latency from the push of the event to the transition
+        if (stats && next != state) {
+            uint64_t latency = event_now_ns() - event.timestamp_ns;
+            stats->transitions++;
+            stats->total_latency_ns += latency;
+            if (latency > stats->max_latency_ns) stats->max_latency_ns = latency;
+        }
+        state = next;
+    }
+    return state;
+}
+
+/* Producer for the demo: reads lines from the keyboard and pushes events.
+   The blocking getchar() sleeps in the kernel, so it does not use CPU either. */
+static void *keyboard_producer(void *arg)
+{
+    EventQueue *q = arg;
+    int c;
+
+    while ((c = getchar()) != EOF) {
+        if (c == 's' || c == 'S') event_queue_push(q, EVENT_START, 0);
+        if (c == 'p' || c == 'P') event_queue_push(q, EVENT_STOP, 0);
+        if (c == 'x' || c == 'X') {
+            event_queue_push(q, EVENT_SHUTDOWN, 0);
+            break;
+        }
+    }
+
+    // end of input also stops the machine
+    if (c == EOF) event_queue_push(q, EVENT_SHUTDOWN, 0);
+    return NULL;
+}
+
+/* Main for the event-driven state machine demo */
+int main_events(void)
+{
+    EventQueue q;
+    EventStats stats = {0};
+    pthread_t producer;
+
+    if (!event_queue_init(&q, 64)) return 1;
+
+    printf("State machine (event-driven) started.\n");
+    printf("Type 's' (start), 'p' (stop) or 'x' (shutdown) and press Enter.\n\n");
+
+    if (pthread_create(&producer, NULL, keyboard_producer, &q) != 0) {
+        event_queue_free(&q);
+        return 1;
+    }
+
+    event_machine_run(event_transitions, EVENT_TRANSITION_COUNT, &q, &stats);
+    pthread_join(producer, NULL);
+
+    printf("State machine terminated after %llu transitions", (unsigned long long)stats.transitions);
+    if (stats.transitions)
+        printf(", average event-to-transition latency %.1f us",
+               stats.total_latency_ns / 1000.0 / stats.transitions);
+    printf(".\n");
+
+    event_queue_free(&q);
+    return 0;
+}
+
+/* One step of the reactor demo, prints the transition if there is one */
+static State reactor_demo_step(State state, EventType event)
+{
+    State next = event_machine_step(event_transitions, EVENT_TRANSITION_COUNT, state, event);
+    if (next != state)
+        printf("State: %s -> %s\n", state_name(state), state_name(next));
+    return next;
+}
+
+/* Seconds without a key press before the reactor demo shuts the machine down */
+#define REACTOR_IDLE_TIMEOUT 60
+
+/*
+ * main_reactor - the event-driven machine on a single thread
+ * The epoll reactor sleeps until the keyboard (raw mode, no Enter needed)
+ * or the one-second timerfd is readable, the handlers push events and the
+ * machine consumes them. Between key presses the only wake-ups are the
+ * timerfd ticks, which count the idle time.
+ */
+int main_reactor(void)
+{
+    Reactor reactor;
+    EventQueue q;
+    State state = STATE_INIT;
+    unsigned idle_seconds = 0;
+
+    if (!event_queue_init(&q, 64)) return 1;
+    if (!reactor_init(&reactor)) {
+        event_queue_free(&q);
+        return 1;
+    }
+
+    if (!reactor_watch_keyboard(&reactor, &q) ||
+        !reactor_add_timer(&reactor, 1000, &q, EVENT_TIMEOUT)) {
+        reactor_free(&reactor);
+        event_queue_free(&q);
+        return 1;
+    }
+
+    printf("State machine (epoll reactor) started.\n");
+    printf("Press 's' (start), 'p' (stop) or 'x' (shutdown).\n\n");
+
+    while (state != STATE_STOP) {
+        // unconditional transitions first, then sleep until input arrives
+        State next = reactor_demo_step(state, EVENT_NONE);
+        if (next != state) {
+            state = next;
+            continue;
+        }
+        if (reactor_run_once(&reactor, -1) < 0) break;
+
+        Event event;
+        while (state != STATE_STOP && event_queue_try_pop(&q, &event)) {
+            if (event.type == EVENT_TIMEOUT) {
+                if (++idle_seconds < REACTOR_IDLE_TIMEOUT) continue;
+                event.type = EVENT_SHUTDOWN;
+            } else {
+                idle_seconds = 0;
+            }
+            state = reactor_demo_step(state, event.type);
+        }
+    }
+
+    printf("State machine terminated.\n");
+
+    // reactor_free also restores the terminal
+    reactor_free(&reactor);
+    event_queue_free(&q);
+    return 0;
+}
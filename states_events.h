@@ -0,0 +1,51 @@
+/*
+ * states_events.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Event-driven state machine - header file
+ */
+
+#ifndef STATES_EVENTS_H
+#define STATES_EVENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "transition_table.h"
+#include "event_queue.h"
+
+/* Latency between pushing an event and the transition it causes */
+typedef struct {
+    uint64_t transitions;
+    uint64_t total_latency_ns;
+    uint64_t max_latency_ns;
+} EventStats;
+
+bool event_is_start(void);
+bool event_is_stop(void);
+bool event_is_shutdown(void);
+
+State event_machine_step(const Transition *table, size_t count, State state, EventType event);
+State event_machine_run(const Transition *table, size_t count, EventQueue *q, EventStats *stats);
+int main_events(void);
+int main_reactor(void);
+
+#endif
@@ -23,20 +23,14 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
 #include <sys/select.h>
-#include <termios.h>
-
-/* Define states */
-typedef enum {
-    STATE_INIT,
-    STATE_STILL,
-    STATE_MOVING,
-    STATE_STOP
-} State;
+#include "terminal.h"
+#include "state_machine.h"
 
 /* Function needed to check if user pressed exit
     This function reads one character from stdin
@@ -57,39 +51,17 @@ bool user_pressed_exit(void) {
     Puts terminal in raw mode to detect individual key presses
 */
 bool user_pressed_exit_nonblocking(void) {
-    // Static variables persist across function calls
-    // we need it to store terminal settings
-    static struct termios old_termios, new_termios;
-
     // Boolean flag to track if terminal has been configured (only configure once)
     // because this function is called repeatedly in the state machine
     static bool terminal_configured = false;
     
     // Configure terminal to raw mode on first call only
     if (!terminal_configured) {
-        // Save the current terminal settings to old_termios 
-        // so we can restore them later
-        tcgetattr(STDIN_FILENO, &old_termios);
-
-        // Copy the current settings to new_termios to modify them
-        new_termios = old_termios;
-        
-        // Disable canonical mode and echo
-        // ICANON: disables canonical (line-buffered) mode 
-        // characters available immediately
-        // ECHO: disables echoing - characters won't be printed to screen
-        new_termios.c_lflag &= ~(ICANON | ECHO);
-
-        // VMIN = 0: minimum characters to read is 0 
-        // (non-blocking if no data available)
-        new_termios.c_cc[VMIN] = 0;
-
-        // VTIME = 0: timeout in deciseconds 
-        // 0 means no timeout, read returns immediately
-        new_termios.c_cc[VTIME] = 0;
-        
-        // Apply the new terminal settings immediately (TCSANOW means "now")
-        tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
+        // Disable canonical mode and echo (single keys, not printed), and
+        // VMIN = 0: read() returns immediately when no key is available.
+        // terminal_raw_mode saves the current settings first and restores
+        // them at exit (only if they could be saved)
+        terminal_raw_mode(0);
 
         // Mark that terminal has been configured so we don't do it again
         terminal_configured = true;
@@ -0,0 +1,85 @@
+/*
+ * terminal.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Raw terminal mode with one saved copy of the original settings.
+ */
+
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include "terminal.h"
+
+/* Terminal settings from before the first switch to raw mode */
+static struct termios saved_termios;
+static int terminal_saved = 0;
+
+/*
+ * terminal_raw_mode - no line buffering and no echo, so single keys are delivered
+ * @min_chars: VMIN - 1 = read() waits for a key, 0 = read() returns at once
+ *
+ * Returns: 1 if stdin is a terminal in raw mode now, 0 otherwise
+ * The original settings are restored by terminal_restore, also at exit()
+ */
+int terminal_raw_mode(int min_chars)
+{
+    static int registered = 0;
+
+    if (!isatty(STDIN_FILENO)) return 0;
+
+    // Save the current terminal settings (once) so we can restore them later
+    if (!terminal_saved) {
+        if (tcgetattr(STDIN_FILENO, &saved_termios) != 0) return 0;
+        terminal_saved = 1;
+    }
+
+    // Copy the saved settings to modify them
+    struct termios raw = saved_termios;
+
+    // ICANON: disables canonical (line-buffered) mode, characters available immediately
+    // ECHO: disables echoing - characters won't be printed to screen
+    raw.c_lflag &= ~(ICANON | ECHO);
+
+    // VMIN: minimum characters a read() waits for (0 = non-blocking)
+    // VTIME = 0: no timeout
+    raw.c_cc[VMIN] = (cc_t)min_chars;
+    raw.c_cc[VTIME] = 0;
+
+    // Apply the new terminal settings immediately (TCSANOW means "now")
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0) return 0;
+
+    // only now there is something to restore
+    if (!registered) {
+        atexit(terminal_restore);
+        registered = 1;
+    }
+    return 1;
+}
+
+// Put the terminal back the way we found it (safe to call more than once)
+void terminal_restore(void)
+{
+    if (terminal_saved) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+        terminal_saved = 0;
+    }
+}
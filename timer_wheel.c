@@ -0,0 +1,151 @@
+/*
+ * timer_wheel.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Single-level timer wheel with intrusive per-slot lists.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "timer_wheel.h"
+
+/*
+ * timer_wheel_init - create a wheel for ids 0 .. id_count-1
+ * @w: wheel to initialize
+ * @id_count: number of ids (one timer per id)
+ * @max_timeout: longest timeout that will be scheduled, in ticks
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int timer_wheel_init(TimerWheel *w, size_t id_count, uint32_t max_timeout)
+{
+    if (!w || id_count >= TIMER_NONE || max_timeout == 0 || max_timeout >= (1u << 31)) return 0;
+    memset(w, 0, sizeof(*w));
+
+    // more slots than the longest timeout: a new timer never lands in the current slot
+    uint32_t slots = 1;
+    while (slots <= max_timeout) slots <<= 1;
+
+    size_t ids = id_count ? id_count : 1;
+    w->mask = slots - 1;
+    w->max_timeout = max_timeout;
+    w->id_count = id_count;
+    w->heads = malloc(slots * sizeof(uint32_t));
+    w->next = malloc(ids * sizeof(uint32_t));
+    w->prev = malloc(ids * sizeof(uint32_t));
+    w->slot_of = malloc(ids * sizeof(uint32_t));
+
+    if (!w->heads || !w->next || !w->prev || !w->slot_of) {
+        timer_wheel_free(w);
+        return 0;
+    }
+
+    // all bytes 0xFF = TIMER_NONE everywhere
+    memset(w->heads, 0xFF, slots * sizeof(uint32_t));
+    memset(w->slot_of, 0xFF, ids * sizeof(uint32_t));
+    return 1;
+}
+
+// Release the wheel
+void timer_wheel_free(TimerWheel *w)
+{
+    if (!w) return;
+
+    free(w->heads);
+    free(w->next);
+    free(w->prev);
+    free(w->slot_of);
+    memset(w, 0, sizeof(*w));
+}
+
+// Take id out of its slot list (the timer must be pending)
+static void unlink_timer(TimerWheel *w, uint32_t id)
+{
+    uint32_t next = w->next[id];
+    uint32_t prev = w->prev[id];
+
+    if (prev == TIMER_NONE)
+        w->heads[w->slot_of[id]] = next;
+    else
+        w->next[prev] = next;
+    if (next != TIMER_NONE)
+        w->prev[next] = prev;
+
+    w->slot_of[id] = TIMER_NONE;
+}
+
+/*
+ * timer_wheel_schedule - expire id after timeout ticks (replaces a pending timer)
+ * @timeout: 1 .. max_timeout
+ *
+ * Returns: 1 on success, 0 if id or timeout is out of range
+ */
+int timer_wheel_schedule(TimerWheel *w, uint32_t id, uint32_t timeout)
+{
+    if (id >= w->id_count || timeout == 0 || timeout > w->max_timeout) return 0;
+
+    if (w->slot_of[id] != TIMER_NONE)
+        unlink_timer(w, id);
+
+    uint32_t slot = (uint32_t)((w->now + timeout) & w->mask);
+    uint32_t head = w->heads[slot];
+
+    w->next[id] = head;
+    w->prev[id] = TIMER_NONE;
+    if (head != TIMER_NONE)
+        w->prev[head] = id;
+    w->heads[slot] = id;
+    w->slot_of[id] = slot;
+    return 1;
+}
+
+// Cancel the timer of id (nothing happens if none is pending)
+void timer_wheel_cancel(TimerWheel *w, uint32_t id)
+{
+    if (id < w->id_count && w->slot_of[id] != TIMER_NONE)
+        unlink_timer(w, id);
+}
+
+/*
+ * timer_wheel_tick - advance the time by one tick and expire the timers of that tick
+ * @expired: called once per expired id
+ *
+ * Returns: number of expired timers
+ * The work is proportional to the number of expired timers, not to the
+ * number of pending ones.
+ */
+size_t timer_wheel_tick(TimerWheel *w, TimerExpired expired, void *context)
+{
+    size_t fired = 0;
+
+    w->now++;
+    uint32_t slot = (uint32_t)(w->now & w->mask);
+
+    // pop from the head, so the callback may cancel or schedule other timers safely
+    while (w->heads[slot] != TIMER_NONE) {
+        uint32_t id = w->heads[slot];
+        unlink_timer(w, id);
+        fired++;
+        if (expired) expired(id, context);
+    }
+    return fired;
+}
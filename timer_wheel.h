@@ -0,0 +1,82 @@
+/*
+ * timer_wheel.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Timer wheel for per-instance timeouts.
+ * One timer per id (instance), kept in an intrusive doubly linked list per
+ * slot, so scheduling, cancelling and one tick are O(1): a tick only looks at
+ * the slot of the current time. The wheel has more slots than the longest
+ * timeout, so every timer in a slot expires when the slot comes around
+ * (no 'rounds' to count down and skip).
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMER_NONE UINT32_MAX
+
+// called for every expired id; it may schedule or cancel any timer
+typedef void (*TimerExpired)(uint32_t id, void *context);
+
+typedef struct {
+    uint64_t  now;          // ticks since init
+    uint32_t  mask;         // slot count - 1 (power of two)
+    uint32_t  max_timeout;  // longest allowed timeout in ticks
+    size_t    id_count;
+    uint32_t *heads;        // first id in every slot
+    uint32_t *next;         // per id: next id in the same slot
+    uint32_t *prev;         // per id: previous id, TIMER_NONE = head of the slot
+    uint32_t *slot_of;      // per id: slot of the pending timer, TIMER_NONE = no timer
+} TimerWheel;
+
+int timer_wheel_init(TimerWheel *w, size_t id_count, uint32_t max_timeout);
+void timer_wheel_free(TimerWheel *w);
+int timer_wheel_schedule(TimerWheel *w, uint32_t id, uint32_t timeout);
+void timer_wheel_cancel(TimerWheel *w, uint32_t id);
+size_t timer_wheel_tick(TimerWheel *w, TimerExpired expired, void *context);
+
+// Is a timer pending for id?
+static inline int timer_wheel_pending(const TimerWheel *w, uint32_t id)
+{
+    return w->slot_of[id] != TIMER_NONE;
+}
+
+/* Move the clock to now without expiring anything (for restoring saved timers)
+   Pending timers keep their absolute expiry tick, so they must all still be
+   in the future and at most max_timeout ticks away. */
+static inline void timer_wheel_set_time(TimerWheel *w, uint64_t now)
+{
+    w->now = now;
+}
+
+// Ticks until the timer of id expires, 0 = no timer pending
+static inline uint32_t timer_wheel_remaining(const TimerWheel *w, uint32_t id)
+{
+    uint32_t slot = w->slot_of[id];
+    if (slot == TIMER_NONE) return 0;
+    return (uint32_t)((slot - w->now) & w->mask);
+}
+
+#endif
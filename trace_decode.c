@@ -0,0 +1,116 @@
+/*
+ * trace_decode.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * trace_decode - prints a transition trace written by state_trace_dump()
+ * usage: ./trace_decode <file.trace>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "state_trace.h"
+
+/* State names from the same list that defines the enum; engines with more
+   states than the demo print the other states as numbers */
+#define TRACE_STATE_NAME(name, arg) #name,
+static const char *const trace_state_names[STATE_COUNT] = {
+    STATE_LIST(TRACE_STATE_NAME, _)
+};
+
+static void print_state(uint16_t state)
+{
+    if (state < STATE_COUNT)
+        printf("%-7s", trace_state_names[state]);
+    else
+        printf("%-7u", state);
+}
+
+static void print_record(uint32_t thread, const TraceRecord *r, uint64_t start_ns)
+{
+    printf("%12.3f us  thread %-3" PRIu32 " instance %-8" PRIu32 " ",
+           (r->timestamp_ns - start_ns) / 1000.0, thread, r->instance);
+    print_state(r->from);
+    printf(" -> ");
+    print_state(r->to);
+    if (r->transition == STATE_TRACE_TIMEOUT)
+        printf("  (timeout)\n");
+    else
+        printf("  (row %" PRIu32 ")\n", r->transition);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <file.trace>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file = fopen(argv[1], "rb");
+    if (!file) {
+        perror("Failed to open file");
+        return 1;
+    }
+
+    TraceFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != STATE_TRACE_MAGIC ||
+        header.version != STATE_TRACE_VERSION || header.record_size != sizeof(TraceRecord)) {
+        fprintf(stderr, "%s: not a trace file (or an unsupported version)\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+
+    // load all rings, the times are printed relative to the oldest record
+    TraceRingHeader *rings = calloc(header.ring_count ? header.ring_count : 1, sizeof(TraceRingHeader));
+    TraceRecord **records = calloc(header.ring_count ? header.ring_count : 1, sizeof(TraceRecord *));
+    uint64_t start_ns = UINT64_MAX;
+    uint64_t total = 0;
+    int ok = rings && records;
+
+    for (uint32_t i = 0; ok && i < header.ring_count; i++) {
+        ok = fread(&rings[i], sizeof(TraceRingHeader), 1, file) == 1 &&
+             rings[i].count <= STATE_TRACE_RING_SIZE;
+        if (!ok) break;
+
+        records[i] = malloc((rings[i].count ? rings[i].count : 1) * sizeof(TraceRecord));
+        ok = records[i] && fread(records[i], sizeof(TraceRecord), rings[i].count, file) == rings[i].count;
+        if (ok && rings[i].count > 0 && records[i][0].timestamp_ns < start_ns)
+            start_ns = records[i][0].timestamp_ns;
+        total += rings[i].count;
+    }
+
+    if (ok) {
+        printf("%" PRIu64 " transitions from %" PRIu32 " thread(s)\n", total, header.ring_count);
+        for (uint32_t i = 0; i < header.ring_count; i++)
+            for (uint32_t k = 0; k < rings[i].count; k++)
+                print_record(rings[i].thread, &records[i][k], start_ns);
+    } else {
+        fprintf(stderr, "%s: truncated trace file\n", argv[1]);
+    }
+
+    for (uint32_t i = 0; records && i < header.ring_count; i++)
+        free(records[i]);
+    free(records);
+    free(rings);
+    fclose(file);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/*
+ * transition_index.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Builds the per-state transition index from a transition table.
+ */
+
+#include <stdlib.h>
+#include "transition_index.h"
+
+/*
+ * transition_index_build - group the table by 'from' state (counting sort)
+ * @index: index to fill
+ * @table: transition table, in priority order
+ * @count: number of transitions in the table
+ * @state_count: number of states (all states must be below it)
+ *
+ * Returns: 1 on success, 0 on failure
+ * The sort is stable, so the transitions of a state keep their table order
+ * and the first-match semantics do not change.
+ */
+int transition_index_build(TransitionIndex *index, const Transition *table, size_t count,
+                           size_t state_count)
+{
+    if (!index || (!table && count > 0) || count > UINT32_MAX) return 0;
+
+    index->state_count = state_count;
+    index->offsets = calloc(state_count + 1, sizeof(uint32_t));
+    index->transitions = malloc((count ? count : 1) * sizeof(CompiledTransition));
+    if (!index->offsets || !index->transitions) {
+        transition_index_free(index);
+        return 0;
+    }
+
+    // 1) count the transitions of every state
+    for (size_t i = 0; i < count; i++) {
+        if ((size_t)table[i].from >= state_count) {
+            transition_index_free(index);
+            return 0;
+        }
+        index->offsets[table[i].from + 1]++;
+    }
+
+    // 2) prefix sum: where the transitions of every state start
+    for (size_t s = 0; s < state_count; s++)
+        index->offsets[s + 1] += index->offsets[s];
+
+    // 3) place the transitions, in table order within each state
+    uint32_t *next = malloc((state_count ? state_count : 1) * sizeof(uint32_t));
+    if (!next) {
+        transition_index_free(index);
+        return 0;
+    }
+    for (size_t s = 0; s < state_count; s++)
+        next[s] = index->offsets[s];
+
+    for (size_t i = 0; i < count; i++) {
+        CompiledTransition *t = &index->transitions[next[table[i].from]++];
+        t->guard = table[i].guard;
+        t->to = table[i].to;
+        t->row = (uint32_t)i;
+    }
+
+    free(next);
+    return 1;
+}
+
+/*
+ * transition_index_build_nested - index for nested (hierarchical) states
+ * @parents: parent of every state, -1 = no parent (NULL = no nesting)
+ *
+ * Returns: 1 on success, 0 on failure (also for a parent out of range or a cycle)
+ * The transitions of state s are its own, then those of its parent, then
+ * those of the grandparent and so on - the innermost state has priority.
+ */
+int transition_index_build_nested(TransitionIndex *index, const Transition *table, size_t count,
+                                  size_t state_count, const int *parents)
+{
+    if (!transition_index_build(index, table, count, state_count)) return 0;
+    if (!parents) return 1;
+
+    // 1) validate the tree and count the transitions along every chain
+    uint32_t *offsets = calloc(state_count + 1, sizeof(uint32_t));
+    if (!offsets) {
+        transition_index_free(index);
+        return 0;
+    }
+
+    for (size_t s = 0; s < state_count; s++) {
+        size_t depth = 0;
+        uint64_t total = 0;
+        for (int a = (int)s; a >= 0; a = parents[a]) {
+            if ((size_t)a >= state_count || ++depth > state_count) {
+                free(offsets);
+                transition_index_free(index);
+                return 0;
+            }
+            total += index->offsets[a + 1] - index->offsets[a];
+        }
+        if (total > UINT32_MAX - offsets[s]) {
+            free(offsets);
+            transition_index_free(index);
+            return 0;
+        }
+        offsets[s + 1] = offsets[s] + (uint32_t)total;
+    }
+
+    // 2) copy every chain: own transitions first, then the ancestors'
+    CompiledTransition *flat = malloc((offsets[state_count] ? offsets[state_count] : 1) *
+                                      sizeof(CompiledTransition));
+    if (!flat) {
+        free(offsets);
+        transition_index_free(index);
+        return 0;
+    }
+
+    for (size_t s = 0; s < state_count; s++) {
+        CompiledTransition *out = flat + offsets[s];
+        for (int a = (int)s; a >= 0; a = parents[a]) {
+            for (uint32_t t = index->offsets[a]; t < index->offsets[a + 1]; t++)
+                *out++ = index->transitions[t];
+        }
+    }
+
+    free(index->offsets);
+    free(index->transitions);
+    index->offsets = offsets;
+    index->transitions = flat;
+    return 1;
+}
+
+// Release the index
+void transition_index_free(TransitionIndex *index)
+{
+    if (!index) return;
+
+    free(index->offsets);
+    free(index->transitions);
+    index->offsets = NULL;
+    index->transitions = NULL;
+    index->state_count = 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * transition_index.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Precompiled per-state transition index (CSR layout) for the table-driven
+ * state machine. transition_table_step() scans the whole table on every step;
+ * the index groups the transitions by their 'from' state once, so a step only
+ * looks at the transitions of the current state:
+ *   transitions[offsets[s] .. offsets[s+1])  - transitions leaving state s,
+ *                                              in table (= priority) order
+ * With nested states (parents[s] = parent of s, -1 = top level) the
+ * transitions of the parents are appended after the state's own ones, so a
+ * child handles what it can and everything else bubbles up to its parents -
+ * at no cost at run time.
+ */
+
+#ifndef TRANSITION_INDEX_H
+#define TRANSITION_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "transition_table.h"
+
+// 'from' is implicit in the position, so only the guard and the target are kept
+typedef struct {
+    bool (*guard)(void);
+    State to;
+    uint32_t row;       // position in the original table (for tracing)
+} CompiledTransition;
+
+typedef struct {
+    size_t              state_count;
+    uint32_t           *offsets;        // state_count + 1 entries
+    CompiledTransition *transitions;    // grouped by 'from' state
+} TransitionIndex;
+
+int transition_index_build(TransitionIndex *index, const Transition *table, size_t count,
+                           size_t state_count);
+int transition_index_build_nested(TransitionIndex *index, const Transition *table, size_t count,
+                                  size_t state_count, const int *parents);
+void transition_index_free(TransitionIndex *index);
+
+/* Same semantics as transition_table_step: first transition whose guard is NULL
+   or returns true wins, no match means re-entering the same state */
+static inline State transition_index_step(const TransitionIndex *index, State current_state)
+{
+    if ((size_t)current_state >= index->state_count) return current_state;
+
+    const CompiledTransition *t = index->transitions + index->offsets[current_state];
+    const CompiledTransition *end = index->transitions + index->offsets[current_state + 1];
+
+    for (; t < end; t++) {
+        if (t->guard == NULL || t->guard())
+            return t->to;
+    }
+    return current_state;
+}
+
+#endif
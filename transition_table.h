@@ -0,0 +1,130 @@
+/*
+ * transition_table.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Table-driven state machine - states and the transition table entry
+ * (shared by simple_states_transition_table.c and the faster engines built on it).
+ */
+
+#ifndef TRANSITION_TABLE_H
+#define TRANSITION_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* The states, defined once
+   Everything that depends on the list of states (the enum, the names,
+   the dispatch switch below) is generated from it with X-macros:
+   STATE_LIST(X, arg) expands to X(name, arg) for every state */
+#define STATE_LIST(X, arg) \
+    X(INIT, arg)           \
+    X(STILL, arg)          \
+    X(MOVING, arg)         \
+    X(STOP, arg)
+
+/* Define states */
+#define STATE_ENUM_ENTRY(name, arg) STATE_##name,
+typedef enum {
+    STATE_LIST(STATE_ENUM_ENTRY, _)
+    STATE_COUNT
+} State;
+
+/* State names, generated from the same list (simple_states_transition_table.c) */
+extern const char *const state_names[STATE_COUNT];
+
+static inline const char *state_name(State s)
+{
+    return (unsigned)s < STATE_COUNT ? state_names[s] : "UNKNOWN";
+}
+
+/* Transition table entry
+   - from: state where this transition is considered
+   - guard: function returning true when the transition should be taken
+   - to: next state if guard is true
+*/
+typedef struct {
+    State from;
+    bool (*guard)(void);
+    State to;
+} Transition;
+
+/* Timed transition entry
+   - from: state the timer belongs to
+   - timeout: ticks an instance may stay in 'from' without another transition
+   - to: next state when the timer expires
+*/
+typedef struct {
+    State    from;
+    uint32_t timeout;
+    State    to;
+} TimedTransition;
+
+/* A machine is described once as a list of transitions
+   T(from, guard, to) with the same meaning as the table rows (guard NULL = always),
+   for example:
+       #define MY_TRANSITIONS(T)              \
+           T(INIT,   NULL,         STILL)     \
+           T(STILL,  start_moving, MOVING)
+   From this list we generate
+   - the runtime table:  Transition table[] = { MY_TRANSITIONS(TRANSITION_ROW) };
+   - an inlined dispatch: DEFINE_TRANSITION_DISPATCH(my_step, MY_TRANSITIONS)
+   The dispatch is a switch on the state (a jump table) where every case only
+   contains the rows of that state, and every guard is a direct call that
+   the compiler can inline - no loop and no function pointers at run time. */
+#define TRANSITION_ROW(from, guard, to) { STATE_##from, guard, STATE_##to },
+
+static inline __attribute__((always_inline)) bool transition_guard_call(bool (*guard)(void))
+{
+    // guard is a constant in the generated code, so this folds to a direct call (or to true)
+    return guard == NULL || guard();
+}
+
+// one row inside a case: the state comparison is a constant, rows of other states disappear
+#define TRANSITION_DISPATCH_ROW(from, guard, to) \
+    if (STATE_##from == dispatch_state && transition_guard_call(guard)) return STATE_##to;
+
+#define TRANSITION_DISPATCH_CASE(name, LIST) \
+    case STATE_##name: {                      \
+        const State dispatch_state = STATE_##name; \
+        (void)dispatch_state;                 \
+        LIST(TRANSITION_DISPATCH_ROW)         \
+        break;                                \
+    }
+
+// no transition matched: re-enter the same state (as transition_table_step)
+#define DEFINE_TRANSITION_DISPATCH(fn, LIST)             \
+    static inline State fn(State state)                  \
+    {                                                    \
+        switch (state) {                                 \
+            STATE_LIST(TRANSITION_DISPATCH_CASE, LIST)   \
+            default: break;                              \
+        }                                                \
+        return state;                                    \
+    }
+
+size_t transition_table_match(const Transition *table, size_t count, State current_state);
+State transition_table_step(const Transition *table, size_t count, State current_state);
+State state_machine_step_transitions(State current_state);
+State state_machine_step_compiled(State current_state);
+
+#endif
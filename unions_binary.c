@@ -52,6 +52,11 @@ typedef union {
 } WeekdayBits;
 //#pragma pack()
 
+// the weekday modules (weekday.h) work on this same union, so we tell
+// weekday_bits.h that it is already defined here
+#define WEEKDAY_BITS_DEFINED
+#include "weekday.h"
+
 int bitunions_main(void) {
     // Get the current system time
     time_t now = time(NULL);
@@ -101,6 +106,12 @@ int bitunions_main(void) {
     }
     printf("\n");
 
+    // and the same without any branches: lookup tables and ctz (weekday.h),
+    // the way a loop over millions of schedules would do it
+    WeekdayBits table_day = weekday_from_tm_wday(t->tm_wday);
+    printf("Today is (table): %s (raw value 0x%02X, tm_wday %d)\n",
+           weekday_name(table_day), table_day.value, weekday_to_tm_wday(table_day));
+
     // Show that the union occupies only 1 byte of memory
     printf("Union size: %zu byte\n", sizeof(WeekdayBits));
 
@@ -24,6 +24,7 @@
 
 // This is a union example in C
 #include <stdio.h>
+#include "variant.h"
 
 // a union can hold different data types in the same memory location
 // but only one member can be used at a time
@@ -65,5 +66,32 @@ int unions_main(void) {
     printf("Struct as integer (after setting float): %d\n", ns.i);
     printf("Size of struct: %zu bytes\n", sizeof(ns));
 
+    // a tagged union (variant.h) records which member is active,
+    // so nobody has to guess how to read the memory
+    Variant values[3];
+    values[0] = variant_int32(42);
+    values[1] = variant_float(3.14f);
+    variant_string(&values[2], "hello", 5);
+    for (int k = 0; k < 3; k++) {
+        printf("Variant: ");
+        variant_print(stdout, &values[k]);
+        // serialized: one tag byte and only the bytes of the active member
+        printf(" (%zu bytes serialized)\n", variant_encoded_size(&values[k]));
+    }
+    printf("Size of variant: %zu bytes\n", sizeof(Variant));
+
+    // round trip through a buffer of exactly the serialized size
+    uint8_t encoded[3 * VARIANT_ENCODED_MAX];
+    size_t encoded_size = 0;
+    for (int k = 0; k < 3; k++) encoded_size += variant_encoded_size(&values[k]);
+
+    size_t written = 0, consumed = 0;
+    Variant decoded[3];
+    size_t encoded_count = variant_encode_array(values, 3, encoded, &written);
+    size_t decoded_count = variant_decode_array(encoded, written, decoded, 3, &consumed);
+    int same = encoded_count == 3 && decoded_count == 3 && written == encoded_size && consumed == written;
+    for (int k = 0; k < 3 && same; k++) same = variant_equal(&values[k], &decoded[k]);
+    printf("Variant round trip: %zu bytes, %s\n", written, same ? "ok" : "FAILED");
+
     return 0;
 }
\ No newline at end of file
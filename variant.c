@@ -0,0 +1,179 @@
+/*
+ * variant.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Tagged variant values and their compact serialization.
+ */
+
+#include <inttypes.h>
+#include "variant.h"
+
+const uint8_t variant_payload_size[VARIANT_TYPE_COUNT] = {
+    [VARIANT_NONE]   = 0,
+    [VARIANT_INT32]  = sizeof(int32_t),
+    [VARIANT_INT64]  = sizeof(int64_t),
+    [VARIANT_FLOAT]  = sizeof(float),
+    [VARIANT_DOUBLE] = sizeof(double),
+    [VARIANT_STRING] = 0,
+};
+
+/*
+ * variant_string - make a short string value, stored inline
+ * @v: value to set
+ * @text, @length: the string (need not be terminated)
+ *
+ * Returns: 1 on success, 0 if the string is longer than VARIANT_STRING_MAX
+ */
+int variant_string(Variant *v, const char *text, size_t length)
+{
+    if (length > VARIANT_STRING_MAX) return 0;
+    memset(v, 0, sizeof(*v));
+    memcpy(v->as.str, text, length);
+    v->type = VARIANT_STRING;
+    v->length = (uint8_t)length;
+    return 1;
+}
+
+/*
+ * variant_equal - same type and same value (floats compared bit by bit)
+ *
+ * Returns: 1 if equal, 0 otherwise
+ */
+int variant_equal(const Variant *a, const Variant *b)
+{
+    if (a->type != b->type || a->type >= VARIANT_TYPE_COUNT) return 0;
+    if (a->type == VARIANT_STRING)
+        return a->length == b->length && memcmp(a->as.str, b->as.str, a->length) == 0;
+    return memcmp(&a->as, &b->as, variant_payload_size[a->type]) == 0;
+}
+
+/*
+ * variant_print - print the value with its type, e.g. "int32 42"
+ */
+void variant_print(FILE *out, const Variant *v)
+{
+    switch (v->type) {
+        case VARIANT_INT32:  fprintf(out, "int32 %" PRId32, v->as.i32); break;
+        case VARIANT_INT64:  fprintf(out, "int64 %" PRId64, v->as.i64); break;
+        case VARIANT_FLOAT:  fprintf(out, "float %f", v->as.f32); break;
+        case VARIANT_DOUBLE: fprintf(out, "double %f", v->as.f64); break;
+        case VARIANT_STRING: fprintf(out, "string \"%s\"", v->as.str); break;
+        default:             fprintf(out, "none"); break;
+    }
+}
+
+/*
+ * variant_encode - serialize one value
+ * @v: value
+ * @out: at least variant_encoded_size(v) bytes (VARIANT_ENCODED_MAX for any value)
+ *
+ * Returns: number of bytes written, 0 if the type or string length is invalid
+ * Exactly the payload is written. The numbers are fixed-size copies the
+ * compiler turns into single moves; only a string needs a variable copy.
+ */
+size_t variant_encode(const Variant *v, uint8_t *out)
+{
+    size_t size = variant_encoded_size(v);
+    if (size == 0) return 0;
+
+    uint8_t length = v->type == VARIANT_STRING ? v->length : 0;
+    out[0] = (uint8_t)(v->type | length << 4);
+    switch (v->type) {
+        case VARIANT_INT32:
+        case VARIANT_FLOAT:  memcpy(out + 1, &v->as, 4); break;
+        case VARIANT_INT64:
+        case VARIANT_DOUBLE: memcpy(out + 1, &v->as, 8); break;
+        case VARIANT_STRING: memcpy(out + 1, v->as.str, length); break;
+        default:             break;
+    }
+    return size;
+}
+
+/*
+ * variant_decode - deserialize one value
+ * @src, @size: encoded bytes
+ * @v: decoded value
+ *
+ * Returns: number of bytes consumed, 0 if the data is truncated or the tag invalid
+ */
+size_t variant_decode(const uint8_t *src, size_t size, Variant *v)
+{
+    if (size < 1) return 0;
+    uint8_t type = src[0] & 0x0F;
+    uint8_t length = src[0] >> 4;
+    if (type >= VARIANT_TYPE_COUNT || (length != 0 && type != VARIANT_STRING)) return 0;
+
+    size_t used = 1 + (size_t)variant_payload_size[type] + length;
+    if (size < used) return 0;
+    if (size >= 1 + sizeof(v->as)) {
+        // enough data behind the value: a fixed-size copy, the bytes past the payload are ignored
+        memcpy(&v->as, src + 1, sizeof(v->as));
+    } else {
+        memset(&v->as, 0, sizeof(v->as));
+        memcpy(&v->as, src + 1, used - 1);
+    }
+    if (type == VARIANT_STRING) v->as.str[length] = '\0';
+    v->type = type;
+    v->length = length;
+    return used;
+}
+
+/*
+ * variant_encode_array - serialize values back to back
+ * @out: the sum of variant_encoded_size() of the values
+ *       (count * VARIANT_ENCODED_MAX is always enough)
+ * @written: optional, bytes written for the encoded values
+ *
+ * Returns: number of values encoded; stops at the first invalid value
+ */
+size_t variant_encode_array(const Variant *values, size_t count, uint8_t *out, size_t *written)
+{
+    size_t offset = 0, n = 0;
+    while (n < count) {
+        size_t used = variant_encode(&values[n], out + offset);
+        if (used == 0) break;
+        offset += used;
+        n++;
+    }
+    if (written) *written = offset;
+    return n;
+}
+
+/*
+ * variant_decode_array - deserialize up to count values
+ * @consumed: optional, bytes used by the decoded values
+ *
+ * Returns: number of values decoded; stops at the end of the data or at the
+ *          first invalid value
+ */
+size_t variant_decode_array(const uint8_t *src, size_t size, Variant *values, size_t count, size_t *consumed)
+{
+    size_t offset = 0, n = 0;
+    while (n < count) {
+        size_t used = variant_decode(src + offset, size - offset, &values[n]);
+        if (used == 0) break;
+        offset += used;
+        n++;
+    }
+    if (consumed) *consumed = offset;
+    return n;
+}
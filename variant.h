@@ -0,0 +1,95 @@
+/*
+ * variant.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Tagged variant values: union Number with a tag, so that a reader always
+ * knows the active member. Short strings are stored inline (no heap).
+ * Serialized as one tag byte plus a payload sized to the active type:
+ *   tag     - low nibble: VariantType, high nibble: string length
+ *   payload - int32/float: 4 bytes, int64/double: 8 bytes, string: length
+ *             bytes (no terminator), none: nothing
+ * Numbers are in host byte order (little-endian files, as Person files).
+ */
+
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+    VARIANT_NONE = 0,
+    VARIANT_INT32,
+    VARIANT_INT64,
+    VARIANT_FLOAT,
+    VARIANT_DOUBLE,
+    VARIANT_STRING,
+    VARIANT_TYPE_COUNT
+} VariantType;
+
+// longest inline string; the length must fit in the high nibble of the tag
+#define VARIANT_STRING_MAX 15
+
+// largest serialized value: tag + the longest inline string
+#define VARIANT_ENCODED_MAX (1 + VARIANT_STRING_MAX)
+
+typedef struct {
+    union {
+        int32_t i32;
+        int64_t i64;
+        float   f32;
+        double  f64;
+        char    str[VARIANT_STRING_MAX + 1];   // always terminated
+    } as;
+    uint8_t type;       // VariantType, the active member
+    uint8_t length;     // string length (VARIANT_STRING only)
+} Variant;
+
+static inline Variant variant_int32(int32_t value) { Variant v = { .as.i32 = value, .type = VARIANT_INT32 }; return v; }
+static inline Variant variant_int64(int64_t value) { Variant v = { .as.i64 = value, .type = VARIANT_INT64 }; return v; }
+static inline Variant variant_float(float value)   { Variant v = { .as.f32 = value, .type = VARIANT_FLOAT }; return v; }
+static inline Variant variant_double(double value) { Variant v = { .as.f64 = value, .type = VARIANT_DOUBLE }; return v; }
+
+// payload bytes of each type; a string adds its length
+extern const uint8_t variant_payload_size[VARIANT_TYPE_COUNT];
+
+// serialized size: tag + payload, 0 for an invalid value
+static inline size_t variant_encoded_size(const Variant *v)
+{
+    if (v->type >= VARIANT_TYPE_COUNT) return 0;
+    if (v->type == VARIANT_STRING)
+        return v->length <= VARIANT_STRING_MAX ? 1 + (size_t)v->length : 0;
+    return 1 + (size_t)variant_payload_size[v->type];
+}
+
+int variant_string(Variant *v, const char *text, size_t length);
+int variant_equal(const Variant *a, const Variant *b);
+void variant_print(FILE *out, const Variant *v);
+
+size_t variant_encode(const Variant *v, uint8_t *out);
+size_t variant_decode(const uint8_t *src, size_t size, Variant *v);
+size_t variant_encode_array(const Variant *values, size_t count, uint8_t *out, size_t *written);
+size_t variant_decode_array(const uint8_t *src, size_t size, Variant *values, size_t count, size_t *consumed);
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * variant_column.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Columnar Variant storage: conversion from and to rows, aggregations.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "variant_column.h"
+
+// independent partial sums, so the compiler may reorder floating point
+// additions into vector lanes without -ffast-math
+#define VARIANT_SUM_LANES 8
+
+/*
+ * variant_columns_from_rows - split row-wise variants into columns
+ * @c: columns to fill (one allocation per type, exactly sized)
+ * @rows, @count: the values
+ *
+ * Returns: 1 on success, 0 on a type outside VariantType or on allocation
+ *          failure (c is then empty)
+ * Two passes: count (and check) the values of every type, then scatter them.
+ */
+int variant_columns_from_rows(VariantColumns *c, const Variant *rows, size_t count)
+{
+    memset(c, 0, sizeof(*c));
+    for (size_t i = 0; i < count; i++) {
+        if (rows[i].type >= VARIANT_TYPE_COUNT) {
+            memset(c, 0, sizeof(*c));
+            return 0;
+        }
+        c->counts[rows[i].type]++;
+    }
+    c->count = count;
+
+    c->tags = malloc(count ? count : 1);
+    c->i32 = malloc((c->counts[VARIANT_INT32] + 1) * sizeof(*c->i32));
+    c->i64 = malloc((c->counts[VARIANT_INT64] + 1) * sizeof(*c->i64));
+    c->f32 = malloc((c->counts[VARIANT_FLOAT] + 1) * sizeof(*c->f32));
+    c->f64 = malloc((c->counts[VARIANT_DOUBLE] + 1) * sizeof(*c->f64));
+    c->str = malloc((c->counts[VARIANT_STRING] + 1) * sizeof(*c->str));
+    c->str_length = malloc(c->counts[VARIANT_STRING] + 1);
+    if (!c->tags || !c->i32 || !c->i64 || !c->f32 || !c->f64 || !c->str || !c->str_length) {
+        variant_columns_free(c);
+        return 0;
+    }
+
+    size_t next[VARIANT_TYPE_COUNT] = {0};
+    for (size_t i = 0; i < count; i++) {
+        const Variant *v = &rows[i];
+        size_t k = next[v->type]++;
+        c->tags[i] = v->type;
+        switch (v->type) {
+            case VARIANT_INT32:  c->i32[k] = v->as.i32; break;
+            case VARIANT_INT64:  c->i64[k] = v->as.i64; break;
+            case VARIANT_FLOAT:  c->f32[k] = v->as.f32; break;
+            case VARIANT_DOUBLE: c->f64[k] = v->as.f64; break;
+            case VARIANT_STRING:
+                memcpy(c->str[k], v->as.str, sizeof(c->str[k]));
+                c->str_length[k] = v->length;
+                break;
+        }
+    }
+    return 1;
+}
+
+/*
+ * variant_columns_to_rows - rebuild the row-wise variants
+ * @c: columns
+ * @rows: c->count values
+ * A tag outside VariantType (damaged columns) gives a VARIANT_NONE row.
+ */
+void variant_columns_to_rows(const VariantColumns *c, Variant *rows)
+{
+    size_t next[VARIANT_TYPE_COUNT] = {0};
+    for (size_t i = 0; i < c->count; i++) {
+        Variant *v = &rows[i];
+        uint8_t type = c->tags[i] < VARIANT_TYPE_COUNT ? c->tags[i] : VARIANT_NONE;
+        size_t k = next[type]++;
+        memset(v, 0, sizeof(*v));
+        v->type = type;
+        switch (v->type) {
+            case VARIANT_INT32:  v->as.i32 = c->i32[k]; break;
+            case VARIANT_INT64:  v->as.i64 = c->i64[k]; break;
+            case VARIANT_FLOAT:  v->as.f32 = c->f32[k]; break;
+            case VARIANT_DOUBLE: v->as.f64 = c->f64[k]; break;
+            case VARIANT_STRING:
+                memcpy(v->as.str, c->str[k], sizeof(v->as.str));
+                v->length = c->str_length[k];
+                break;
+        }
+    }
+}
+
+/*
+ * variant_columns_free - release the columns
+ */
+void variant_columns_free(VariantColumns *c)
+{
+    free(c->tags);
+    free(c->i32);
+    free(c->i64);
+    free(c->f32);
+    free(c->f64);
+    free(c->str);
+    free(c->str_length);
+    memset(c, 0, sizeof(*c));
+}
+
+/*
+ * variant_columns_sum_ints - sum of all int32 and int64 values
+ *
+ * Returns: the sum (wraps around on overflow)
+ */
+int64_t variant_columns_sum_ints(const VariantColumns *c)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < c->counts[VARIANT_INT32]; i++) sum += (uint64_t)(int64_t)c->i32[i];
+    for (size_t i = 0; i < c->counts[VARIANT_INT64]; i++) sum += (uint64_t)c->i64[i];
+    return (int64_t)sum;
+}
+
+// VARIANT_SUM_LANES partial sums, added up at the end
+#define DEFINE_LANE_SUM(name, type) \
+    static double name(const type *values, size_t n) \
+    { \
+        double lanes[VARIANT_SUM_LANES] = {0}; \
+        size_t i = 0; \
+        for (; i + VARIANT_SUM_LANES <= n; i += VARIANT_SUM_LANES) \
+            for (int l = 0; l < VARIANT_SUM_LANES; l++) lanes[l] += values[i + l]; \
+        for (; i < n; i++) lanes[0] += values[i]; \
+        double sum = 0; \
+        for (int l = 0; l < VARIANT_SUM_LANES; l++) sum += lanes[l]; \
+        return sum; \
+    }
+
+DEFINE_LANE_SUM(sum_f32, float)
+DEFINE_LANE_SUM(sum_f64, double)
+
+/*
+ * variant_columns_sum_reals - sum of all float and double values, in double
+ *
+ * Returns: the sum; the additions are grouped in VARIANT_SUM_LANES partial
+ *          sums, so the last bits may differ from a sum in row order
+ */
+double variant_columns_sum_reals(const VariantColumns *c)
+{
+    return sum_f32(c->f32, c->counts[VARIANT_FLOAT]) + sum_f64(c->f64, c->counts[VARIANT_DOUBLE]);
+}
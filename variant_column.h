@@ -0,0 +1,59 @@
+/*
+ * variant_column.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Columnar storage for Variant values: one dense array per active type plus
+ * a compact array of one-byte tags. A tag is only the VariantType: unlike
+ * the tag of a serialized Variant it has no string length in the high
+ * nibble (the lengths are a column of their own).
+ * Value k of a type is the k-th value of that type in row order, so no
+ * per-value index is stored. Aggregations run over the dense arrays as
+ * straight loops (vectorized) instead of a switch on every value.
+ */
+
+#ifndef VARIANT_COLUMN_H
+#define VARIANT_COLUMN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "variant.h"
+
+typedef struct {
+    size_t count;                               // number of values (rows)
+    size_t counts[VARIANT_TYPE_COUNT];          // number of values of every type
+    uint8_t *tags;                              // VariantType of every row
+    int32_t *i32;
+    int64_t *i64;
+    float   *f32;
+    double  *f64;
+    char   (*str)[VARIANT_STRING_MAX + 1];      // terminated strings
+    uint8_t *str_length;
+} VariantColumns;
+
+int variant_columns_from_rows(VariantColumns *c, const Variant *rows, size_t count);
+void variant_columns_to_rows(const VariantColumns *c, Variant *rows);
+void variant_columns_free(VariantColumns *c);
+
+int64_t variant_columns_sum_ints(const VariantColumns *c);
+double variant_columns_sum_reals(const VariantColumns *c);
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * weekday.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Lookup tables and bulk conversions for weekday masks.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "weekday.h"
+
+const unsigned char weekday_mask_of_wday[8] = {
+    WEEKDAY_SUN, WEEKDAY_MON, WEEKDAY_TUE, WEEKDAY_WED,
+    WEEKDAY_THU, WEEKDAY_FRI, WEEKDAY_SAT, 0
+};
+
+const signed char weekday_wday_of_bit[8] = { 1, 2, 3, 4, 5, 6, 0, -1 };
+
+const char *const weekday_names[8] = {
+    "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday", ""
+};
+
+// popcount of every 7-bit mask, generated by doubling: table[i + 2^k] = table[i] + 1
+#define POP2(n) n, n + 1, n + 1, n + 2
+#define POP4(n) POP2(n), POP2(n + 1), POP2(n + 1), POP2(n + 2)
+#define POP6(n) POP4(n), POP4(n + 1), POP4(n + 1), POP4(n + 2)
+const unsigned char weekday_popcount[128] = { POP6(0), POP6(1) };
+
+/*
+ * weekday_format - names of all days in the mask, e.g. "Monday, Friday"
+ * @buffer, @size: output (always terminated when size > 0)
+ *
+ * Returns: length of the text (as snprintf)
+ * Loops over the set bits only (ctz), not over all seven days.
+ */
+size_t weekday_format(WeekdayBits days, char *buffer, size_t size)
+{
+    unsigned bits = days.value & WEEKDAY_ALL;
+    size_t length = 0;
+
+    if (size > 0) buffer[0] = '\0';
+    for (; bits; bits &= bits - 1) {
+        const char *name = weekday_names[__builtin_ctz(bits)];
+        int n = snprintf(length < size ? buffer + length : NULL, length < size ? size - length : 0,
+                         "%s%s", length ? ", " : "", name);
+        if (n > 0) length += (size_t)n;
+    }
+    return length;
+}
+
+/*
+ * weekday_masks_from_times - weekday mask of every timestamp
+ * @times, @count: seconds since the epoch
+ * @masks: one WeekdayBits value (mask) per timestamp
+ * @utc_offset: seconds east of UTC (fixed, no daylight saving)
+ *
+ * No localtime(), no branches. The arithmetic pass vectorizes; the mask
+ * is made in a second pass, since SSE2 has no per-element shift.
+ */
+void weekday_masks_from_times(const time_t *times, uint8_t *masks, size_t count, int32_t utc_offset)
+{
+    for (size_t i = 0; i < count; i++)
+        masks[i] = (uint8_t)weekday_bit_of_local((int64_t)times[i] + utc_offset);
+    for (size_t i = 0; i < count; i++)
+        masks[i] = (uint8_t)(1u << masks[i]);
+}
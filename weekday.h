@@ -0,0 +1,94 @@
+/*
+ * weekday.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Weekday conversions without branches.
+ * tm_wday (0 = Sunday), WeekdayBits masks (bit 0 = Monday) and day names are
+ * converted with small constant lookup tables and ctz, so a schedule
+ * evaluation loop has no switch or if chain to mispredict. Timestamps are
+ * converted in bulk with integer arithmetic instead of localtime() per
+ * element.
+ */
+
+#ifndef WEEKDAY_H
+#define WEEKDAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "weekday_bits.h"
+
+// lookup tables (weekday.c); 8 entries so that an index & 7 is always valid
+extern const unsigned char weekday_mask_of_wday[8];     // tm_wday -> mask, 7 -> 0
+extern const signed char   weekday_wday_of_bit[8];      // bit index -> tm_wday, 7 (no day) -> -1
+extern const char *const   weekday_names[8];            // bit index -> name, 7 (no day) -> ""
+extern const unsigned char weekday_popcount[128];       // number of days in a mask
+
+// tm_wday (0 = Sunday ... 6 = Saturday) to a one-day mask
+static inline WeekdayBits weekday_from_tm_wday(int wday)
+{
+    WeekdayBits day = {0};
+    day.value = weekday_mask_of_wday[(unsigned)wday & 7];
+    return day;
+}
+
+// index of the first day in the mask (0 = Monday), 7 for an empty mask
+static inline unsigned weekday_first(WeekdayBits days)
+{
+    // bit 7 is never a day, it stops ctz for an empty mask
+    return (unsigned)__builtin_ctz((days.value & WEEKDAY_ALL) | 0x80u);
+}
+
+// tm_wday of the first day in the mask, -1 for an empty mask
+static inline int weekday_to_tm_wday(WeekdayBits days)
+{
+    return weekday_wday_of_bit[weekday_first(days)];
+}
+
+// name of the first day in the mask ("" for an empty mask)
+static inline const char *weekday_name(WeekdayBits days)
+{
+    return weekday_names[weekday_first(days)];
+}
+
+// number of days in the mask
+static inline unsigned weekday_day_count(WeekdayBits days)
+{
+    return weekday_popcount[days.value & WEEKDAY_ALL];
+}
+
+/* 400 Gregorian years = 146097 days, a whole number of weeks: adding them
+   keeps the weekday and makes every timestamp after 1570 positive */
+#define WEEKDAY_BIAS_SECONDS (146097LL * 86400)
+
+// bit index (0 = Monday) of a local time in seconds since the epoch, years 1570 to 19000
+static inline unsigned weekday_bit_of_local(int64_t local_seconds)
+{
+    // 86400 = 128 * 675: after the shift the division by 675 is 32-bit, which vectorizes
+    uint32_t units = (uint32_t)((uint64_t)(local_seconds + WEEKDAY_BIAS_SECONDS) >> 7);
+    return (units / 675u + 3u) % 7u;    // 1970-01-01 was a Thursday, bit 3
+}
+
+size_t weekday_format(WeekdayBits days, char *buffer, size_t size);
+void weekday_masks_from_times(const time_t *times, uint8_t *masks, size_t count, int32_t utc_offset);
+
+#endif
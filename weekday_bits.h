@@ -0,0 +1,65 @@
+/*
+ * weekday_bits.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * WeekdayBits - one week of flags in one byte, for the weekday modules.
+ */
+
+#ifndef WEEKDAY_BITS_H
+#define WEEKDAY_BITS_H
+
+/*
+ * WeekdayBits union - the same byte as a raw value and as one bit-field per
+ * day. unions_binary.c defines it itself (it is part of the lecture, with the
+ * #pragma pack experiment) and sets WEEKDAY_BITS_DEFINED before including
+ * the weekday headers; the two definitions must stay the same.
+ */
+#ifndef WEEKDAY_BITS_DEFINED
+#define WEEKDAY_BITS_DEFINED
+typedef union {
+    unsigned char value;    // all 8 bits as a single byte
+
+    struct {
+        unsigned mon : 1;   // bit 0
+        unsigned tue : 1;
+        unsigned wed : 1;
+        unsigned thu : 1;
+        unsigned fri : 1;
+        unsigned sat : 1;
+        unsigned sun : 1;   // bit 6
+        unsigned     : 1;   // bit 7: unused
+    } bits;
+} WeekdayBits;
+#endif
+
+/* The same bits as masks for the raw value */
+#define WEEKDAY_COUNT 7
+#define WEEKDAY_MON   (1u << 0)
+#define WEEKDAY_TUE   (1u << 1)
+#define WEEKDAY_WED   (1u << 2)
+#define WEEKDAY_THU   (1u << 3)
+#define WEEKDAY_FRI   (1u << 4)
+#define WEEKDAY_SAT   (1u << 5)
+#define WEEKDAY_SUN   (1u << 6)
+#define WEEKDAY_ALL   0x7Fu
+
+#endif
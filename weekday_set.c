@@ -0,0 +1,204 @@
+/*
+ * weekday_set.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Bit-plane weekday sets and the vectorizable bitset kernels behind them.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "weekday_set.h"
+
+/*
+ * weekday_set_init - create count empty schedules
+ * Returns: 1 on success, 0 on failure
+ */
+int weekday_set_init(WeekdaySet *s, size_t count)
+{
+    if (!s) return 0;
+    memset(s, 0, sizeof(*s));
+
+    s->count = count;
+    s->words = (count + 63) / 64;
+
+    // one allocation for all planes, every plane starts on a cache line
+    size_t plane_words = (s->words + 7) & ~(size_t)7;
+    uint64_t *all = aligned_alloc(64, (plane_words ? plane_words : 8) * WEEKDAY_COUNT * sizeof(uint64_t));
+    if (!all) return 0;
+    memset(all, 0, (plane_words ? plane_words : 8) * WEEKDAY_COUNT * sizeof(uint64_t));
+
+    for (int d = 0; d < WEEKDAY_COUNT; d++)
+        s->planes[d] = all + (size_t)d * plane_words;
+    return 1;
+}
+
+// Release the set
+void weekday_set_free(WeekdaySet *s)
+{
+    if (!s) return;
+    free(s->planes[0]);
+    memset(s, 0, sizeof(*s));
+}
+
+/*
+ * weekday_set_pack - fill the set from one WeekdayBits per user
+ * @rows, @count: schedules of users 0 .. count-1 (at most s->count)
+ * The 64 users of a word are transposed at once (7 words out per 64 bytes in).
+ */
+void weekday_set_pack(WeekdaySet *s, const WeekdayBits *rows, size_t count)
+{
+    if (count > s->count) count = s->count;
+
+    for (size_t w = 0; w * 64 < count; w++) {
+        uint64_t planes[WEEKDAY_COUNT] = {0};
+        size_t n = count - w * 64 < 64 ? count - w * 64 : 64;
+
+        for (size_t j = 0; j < n; j++) {
+            uint64_t v = rows[w * 64 + j].value;
+            for (int d = 0; d < WEEKDAY_COUNT; d++)
+                planes[d] |= ((v >> d) & 1) << j;
+        }
+
+        // keep the users of a partial last word that were not given
+        uint64_t keep = n == 64 ? 0 : ~0ull << n;
+        for (int d = 0; d < WEEKDAY_COUNT; d++)
+            s->planes[d][w] = (s->planes[d][w] & keep) | planes[d];
+    }
+}
+
+// Copy the schedules of users 0 .. count-1 out as WeekdayBits
+void weekday_set_unpack(const WeekdaySet *s, WeekdayBits *rows, size_t count)
+{
+    if (count > s->count) count = s->count;
+
+    for (size_t w = 0; w * 64 < count; w++) {
+        size_t n = count - w * 64 < 64 ? count - w * 64 : 64;
+        for (size_t j = 0; j < n; j++) {
+            unsigned char v = 0;
+            for (int d = 0; d < WEEKDAY_COUNT; d++)
+                v |= (unsigned char)(((s->planes[d][w] >> j) & 1) << d);
+            rows[w * 64 + j].value = v;
+        }
+    }
+}
+
+/* popcount of one word with shifts and adds only (SWAR): unlike
+   __builtin_popcountll without -mpopcnt it is not a library call, and the
+   loops below vectorize with plain SSE2 */
+static inline uint64_t popcount_word(uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    x += x >> 8;
+    x += x >> 16;
+    x += x >> 32;
+    return x & 0x7F;
+}
+
+// dst = a & b (dst may be a or b)
+void bitset_and(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = a[i] & b[i];
+}
+
+// dst = a | b (dst may be a or b)
+void bitset_or(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = a[i] | b[i];
+}
+
+// Number of set bits in n words
+size_t bitset_popcount(const uint64_t *a, size_t n)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++)
+        total += popcount_word(a[i]);
+    return (size_t)total;
+}
+
+/*
+ * match - combine the planes of the days in mask word by word
+ * @all: 1 = AND (active on every day), 0 = OR (active on any day)
+ * @out: the matching users as a bitset of s->words words (NULL = count only)
+ *
+ * Returns: number of matching users
+ * One pass over the data: the planes are combined and counted in blocks
+ * that stay in L1, instead of one full pass per day.
+ */
+static size_t match(const WeekdaySet *s, unsigned mask, int all, uint64_t *out)
+{
+    enum { BLOCK = 512 };
+    uint64_t block[BLOCK];
+    const uint64_t *days[WEEKDAY_COUNT];
+    int day_count = 0;
+    size_t total = 0;
+
+    for (int d = 0; d < WEEKDAY_COUNT; d++)
+        if (mask & (1u << d)) days[day_count++] = s->planes[d];
+
+    for (size_t start = 0; start < s->words; start += BLOCK) {
+        size_t n = s->words - start < BLOCK ? s->words - start : BLOCK;
+        uint64_t *dst = out ? out + start : block;
+
+        if (day_count == 0) {
+            // no day given: AND over nothing matches everybody, OR nobody
+            memset(dst, all ? 0xFF : 0, n * sizeof(uint64_t));
+        } else {
+            memcpy(dst, days[0] + start, n * sizeof(uint64_t));
+            for (int k = 1; k < day_count; k++) {
+                if (all)
+                    bitset_and(dst, dst, days[k] + start, n);
+                else
+                    bitset_or(dst, dst, days[k] + start, n);
+            }
+        }
+
+        // bits past the last user are never set in the planes, but can be by the memset
+        if (start + n == s->words && (s->count & 63))
+            dst[n - 1] &= (1ull << (s->count & 63)) - 1;
+
+        total += bitset_popcount(dst, n);
+    }
+    return total;
+}
+
+// Users active on every day in mask (e.g. WEEKDAY_MON | WEEKDAY_FRI)
+size_t weekday_set_match_all(const WeekdaySet *s, unsigned mask, uint64_t *out)
+{
+    return match(s, mask & WEEKDAY_ALL, 1, out);
+}
+
+// Users active on at least one day in mask
+size_t weekday_set_match_any(const WeekdaySet *s, unsigned mask, uint64_t *out)
+{
+    return match(s, mask & WEEKDAY_ALL, 0, out);
+}
+
+// Number of active users for every weekday (index 0 = Monday, as the bits)
+void weekday_set_day_counts(const WeekdaySet *s, size_t counts[WEEKDAY_COUNT])
+{
+    for (int d = 0; d < WEEKDAY_COUNT; d++)
+        counts[d] = bitset_popcount(s->planes[d], s->words);
+}
@@ -0,0 +1,86 @@
+/*
+ * weekday_set.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Weekday schedules for many users, stored as bit planes.
+ * Plane d holds one bit per user for day d (64 users per uint64), so a
+ * schedule takes exactly 7 bits and questions about whole populations are
+ * word-wide logic over arrays that the compiler vectorizes:
+ *   'active on Monday and Friday'  = plane[mon] & plane[fri]
+ *   'users active per weekday'     = popcount of every plane
+ * Single schedules are still read and written as WeekdayBits.
+ */
+
+#ifndef WEEKDAY_SET_H
+#define WEEKDAY_SET_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "weekday_bits.h"
+
+typedef struct {
+    size_t    count;                    // number of schedules (users)
+    size_t    words;                    // uint64 words per plane
+    uint64_t *planes[WEEKDAY_COUNT];    // plane d: bit i = user i is active on day d
+} WeekdaySet;
+
+int weekday_set_init(WeekdaySet *s, size_t count);
+void weekday_set_free(WeekdaySet *s);
+void weekday_set_pack(WeekdaySet *s, const WeekdayBits *rows, size_t count);
+void weekday_set_unpack(const WeekdaySet *s, WeekdayBits *rows, size_t count);
+
+size_t weekday_set_match_all(const WeekdaySet *s, unsigned mask, uint64_t *out);
+size_t weekday_set_match_any(const WeekdaySet *s, unsigned mask, uint64_t *out);
+void weekday_set_day_counts(const WeekdaySet *s, size_t counts[WEEKDAY_COUNT]);
+
+// whole-array helpers (n words)
+void bitset_and(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n);
+void bitset_or(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n);
+size_t bitset_popcount(const uint64_t *a, size_t n);
+
+// Schedule of user i
+static inline WeekdayBits weekday_set_get(const WeekdaySet *s, size_t i)
+{
+    WeekdayBits days = {0};
+    size_t w = i >> 6;
+    unsigned b = (unsigned)(i & 63);
+
+    for (int d = 0; d < WEEKDAY_COUNT; d++)
+        days.value |= (unsigned char)(((s->planes[d][w] >> b) & 1) << d);
+    return days;
+}
+
+// Replace the schedule of user i
+static inline void weekday_set_put(WeekdaySet *s, size_t i, WeekdayBits days)
+{
+    size_t w = i >> 6;
+    uint64_t bit = 1ull << (i & 63);
+
+    for (int d = 0; d < WEEKDAY_COUNT; d++) {
+        if ((days.value >> d) & 1)
+            s->planes[d][w] |= bit;
+        else
+            s->planes[d][w] &= ~bit;
+    }
+}
+
+#endif
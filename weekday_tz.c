@@ -0,0 +1,143 @@
+/*
+ * weekday_tz.c
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Cached time zone offsets and bulk weekday conversion.
+ */
+
+#include <stdlib.h>
+#include "weekday.h"
+#include "weekday_tz.h"
+
+// timestamps converted per block: the offsets stay in L1
+#define WEEKDAY_TZ_BLOCK 256
+
+static int32_t local_offset(time_t time)
+{
+    struct tm tm;
+    if (!localtime_r(&time, &tm)) return 0;
+    return (int32_t)tm.tm_gmtoff;
+}
+
+static int add_period(WeekdayTz *tz, size_t *capacity, int64_t start, int32_t offset)
+{
+    if (tz->count == *capacity) {
+        size_t grown = *capacity ? *capacity * 2 : 16;
+        int64_t *starts = realloc(tz->starts, grown * sizeof(int64_t));
+        if (!starts) return 0;
+        tz->starts = starts;
+        int32_t *offsets = realloc(tz->offsets, grown * sizeof(int32_t));
+        if (!offsets) return 0;
+        tz->offsets = offsets;
+        *capacity = grown;
+    }
+    tz->starts[tz->count] = start;
+    tz->offsets[tz->count] = offset;
+    tz->count++;
+    return 1;
+}
+
+/*
+ * weekday_tz_init - cache the local time zone (TZ) for [from, to]
+ * @tz: table to fill
+ * @from, @to: range of timestamps to cover; before and after it the first
+ *             and last offset are used
+ *
+ * Returns: 1 on success, 0 on failure
+ * Walks the range a day at a time with localtime_r() and finds every change
+ * of the offset to the second by bisection - about 365 calls per year, once.
+ * Offsets that change and change back within one day are not seen.
+ */
+int weekday_tz_init(WeekdayTz *tz, time_t from, time_t to)
+{
+    size_t capacity = 0;
+    tz->count = 0;
+    tz->starts = NULL;
+    tz->offsets = NULL;
+
+    tzset();
+    int32_t offset = local_offset(from);
+    if (!add_period(tz, &capacity, INT64_MIN, offset)) goto fail;
+
+    for (time_t day = from; day < to; ) {
+        time_t next = to - day > 86400 ? day + 86400 : to;
+        int32_t next_offset = local_offset(next);
+        if (next_offset != offset) {
+            // the change is in (day, next]: bisect to its first second
+            time_t low = day, high = next;
+            while (high - low > 1) {
+                time_t middle = low + (high - low) / 2;
+                if (local_offset(middle) == offset) low = middle;
+                else high = middle;
+            }
+            if (!add_period(tz, &capacity, high, next_offset)) goto fail;
+            offset = next_offset;
+        }
+        day = next;
+    }
+    return 1;
+
+fail:
+    weekday_tz_free(tz);
+    return 0;
+}
+
+/*
+ * weekday_tz_free - release a cached time zone
+ */
+void weekday_tz_free(WeekdayTz *tz)
+{
+    free(tz->starts);
+    free(tz->offsets);
+    tz->starts = NULL;
+    tz->offsets = NULL;
+    tz->count = 0;
+}
+
+/*
+ * weekday_tz_masks - local weekday mask of every timestamp
+ * @tz: cached time zone (only read, so shared between threads)
+ * @times, @count: seconds since the epoch, years 1570 to 19000
+ * @masks: one WeekdayBits value (mask) per timestamp
+ *
+ * Per block: the offsets (branch-free search, skipped when the zone has a
+ * single offset), then the weekday arithmetic, which vectorizes, then the
+ * mask from the bit index.
+ */
+void weekday_tz_masks(const WeekdayTz *tz, const time_t *times, uint8_t *masks, size_t count)
+{
+    int32_t offsets[WEEKDAY_TZ_BLOCK];
+
+    if (tz->count == 1) {
+        weekday_masks_from_times(times, masks, count, tz->offsets[0]);
+        return;
+    }
+    for (size_t base = 0; base < count; base += WEEKDAY_TZ_BLOCK) {
+        size_t n = count - base < WEEKDAY_TZ_BLOCK ? count - base : WEEKDAY_TZ_BLOCK;
+        const time_t *block = times + base;
+        uint8_t *out = masks + base;
+
+        for (size_t i = 0; i < n; i++) offsets[i] = weekday_tz_offset(tz, block[i]);
+        for (size_t i = 0; i < n; i++) out[i] = (uint8_t)weekday_bit_of_local((int64_t)block[i] + offsets[i]);
+        for (size_t i = 0; i < n; i++) out[i] = (uint8_t)(1u << out[i]);
+    }
+}
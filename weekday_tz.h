@@ -0,0 +1,61 @@
+/*
+ * weekday_tz.h
+ * 
+ * Copyright (c) 2026 Miroslaw Staron
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Cached time zone: the local UTC offset as a table of periods.
+ * Built once with localtime_r() (daylight saving transitions included),
+ * read-only afterwards, so any number of threads can convert timestamps to
+ * weekdays with a table lookup and arithmetic - no localtime(), no lock, no
+ * TZ re-read per call.
+ */
+
+#ifndef WEEKDAY_TZ_H
+#define WEEKDAY_TZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef struct {
+    size_t count;       // number of periods
+    int64_t *starts;    // first UTC second of every period, starts[0] = INT64_MIN
+    int32_t *offsets;   // seconds east of UTC in every period
+} WeekdayTz;
+
+int weekday_tz_init(WeekdayTz *tz, time_t from, time_t to);
+void weekday_tz_free(WeekdayTz *tz);
+void weekday_tz_masks(const WeekdayTz *tz, const time_t *times, uint8_t *masks, size_t count);
+
+// UTC offset at a time; the search has no data-dependent branch (cmov)
+static inline int32_t weekday_tz_offset(const WeekdayTz *tz, int64_t time)
+{
+    const int64_t *base = tz->starts;
+    size_t n = tz->count;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = base[half] <= time ? base + half : base;
+        n -= half;
+    }
+    return tz->offsets[base - tz->starts];
+}
+
+#endif